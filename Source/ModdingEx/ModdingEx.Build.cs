@@ -51,7 +51,7 @@ public class ModdingEx : ModuleRules
 				"SlateCore",
 				"ToolWidgets", "Json", "Kismet", "BlueprintGraph", "FileUtilities", "PropertyEditor", "HTTP",
 				"JsonUtilities", "ContentBrowserData",
-				"DeveloperToolSettings"
+				"DeveloperToolSettings", "AssetRegistry", "EditorSubsystem", "PakFile", "DirectoryWatcher"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
@@ -68,10 +68,20 @@ public class ModdingEx : ModuleRules
 		PublicIncludePaths.Add(Path.Combine(ThirdPartyFolder, "include"));
 
 		var LibraryFolder = Path.Combine(ThirdPartyFolder, "lib");
-		
-		PublicAdditionalLibraries.Add(Path.Combine(LibraryFolder, "zip.lib"));
-		PublicAdditionalLibraries.Add(Path.Combine(LibraryFolder, "zlibstatic.lib"));
+
+		// The engine's zlib, for the streaming zip writer and for libzip. Its headers are the ones the writer compiles against,
+		// so no second zlib is linked and every zip is deflated by the same version
+		AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
 
 		var BinaryFolder = Path.Combine(ThirdPartyFolder, "bin");
+
+		// Only Windows builds of libzip ship with the plugin, the .uplugin limits the module to Win64 accordingly
+		if (Target.Platform == UnrealTargetPlatform.Win64)
+		{
+			PublicAdditionalLibraries.Add(Path.Combine(LibraryFolder, "zip.lib"));
+
+			// Restart Manager, finds the processes holding deployed paks open
+			PublicSystemLibraries.Add("Rstrtmgr.lib");
+		}
 	}
 }
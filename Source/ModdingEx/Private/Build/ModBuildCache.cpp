@@ -0,0 +1,178 @@
+#include "Build/ModBuildCache.h"
+
+#include "ModdingEx.h"
+#include "Build/ModBuildContext.h"
+#include "Build/ModDeploy.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+
+namespace ModBuildCache
+{
+	// Touched on every hit, its timestamp orders the entries for eviction
+	const TCHAR* LastUsedFileName = TEXT("LastUsed");
+
+	FString GetCacheDir()
+	{
+		return FPaths::ProjectIntermediateDir() / TEXT("ModdingExCache");
+	}
+
+	FString ComputeKey(const FModBuildContext& Context)
+	{
+		if (Context.IsBatch() || Context.Inputs.IsEmpty())
+		{
+			return FString();
+		}
+
+		const FModBuildSettingsSnapshot& Settings = Context.BuildSettings;
+
+		FSHA1 Sha;
+		auto AddString = [&Sha](const FString& Value)
+		{
+			Sha.UpdateWithString(*Value, Value.Len() + 1);
+		};
+
+		AddString(Context.ModName);
+		AddString(Settings.EngineVersion);
+		AddString(Settings.Platform);
+		AddString(Settings.bUseIoStore ? TEXT("IoStore") : TEXT("Pak"));
+		AddString(Settings.bCompressed ? TEXT("Compressed") : TEXT("Uncompressed"));
+		AddString(Settings.CompressionFormats);
+		AddString(Settings.CompressionOptions);
+
+		for (const FModBuildManifestFile& Input : Context.Inputs)
+		{
+			if (Input.Hash.IsEmpty())
+			{
+				return FString();
+			}
+
+			AddString(Input.Path);
+			AddString(Input.Hash);
+		}
+
+		Sha.Final();
+		FSHAHash Hash;
+		Sha.GetHash(Hash.Hash);
+		return Hash.ToString();
+	}
+
+	bool Find(const FString& Key, const TArray<FString>& FileNames, TArray<FString>& OutFilePaths)
+	{
+		IFileManager& FileManager = IFileManager::Get();
+		const FString EntryDir = GetCacheDir() / Key;
+
+		OutFilePaths.Empty();
+		for (const FString& FileName : FileNames)
+		{
+			const FString FilePath = EntryDir / FileName;
+			if (!FileManager.FileExists(*FilePath))
+			{
+				return false;
+			}
+			OutFilePaths.Add(FilePath);
+		}
+
+		FileManager.SetTimeStamp(*(EntryDir / LastUsedFileName), FDateTime::UtcNow());
+		return true;
+	}
+
+	bool Store(const FString& Key, const TArray<FModBuildOutputFile>& Files)
+	{
+		IFileManager& FileManager = IFileManager::Get();
+		const FString EntryDir = GetCacheDir() / Key;
+		const FString TempEntryDir = EntryDir + TEXT(".tmp");
+
+		if (FileManager.DirectoryExists(*EntryDir))
+		{
+			return true;
+		}
+
+		// Filled next to its final name and renamed at the end, so a lookup never sees a partial entry
+		FileManager.DeleteDirectory(*TempEntryDir, false, true);
+		for (const FModBuildOutputFile& File : Files)
+		{
+			EModDeployMethod Method;
+			if (!ModDeploy::DeployFile(File.SourcePath, TempEntryDir / FPaths::GetCleanFilename(File.DestPath), true, Method))
+			{
+				UE_LOG(LogModdingEx, Warning, TEXT("Failed to add '%s' to the build cache"), *File.SourcePath);
+				FileManager.DeleteDirectory(*TempEntryDir, false, true);
+				return false;
+			}
+		}
+
+		FFileHelper::SaveStringToFile(FString(), *(TempEntryDir / LastUsedFileName));
+
+		if (!FileManager.Move(*EntryDir, *TempEntryDir, true, true, false, true))
+		{
+			FileManager.DeleteDirectory(*TempEntryDir, false, true);
+			return false;
+		}
+
+		UE_LOG(LogModdingEx, Log, TEXT("Stored build output in cache entry %s"), *Key);
+		return true;
+	}
+
+	void Evict(int64 MaxBytes, const FString& KeepKey)
+	{
+		IFileManager& FileManager = IFileManager::Get();
+
+		struct FCacheEntry
+		{
+			FString Dir;
+			FDateTime LastUsed;
+			int64 Size = 0;
+		};
+
+		TArray<FCacheEntry> Entries;
+		int64 TotalSize = 0;
+
+		FileManager.IterateDirectory(*GetCacheDir(), [&](const TCHAR* FilenameOrDirectory, bool bIsDirectory)
+		{
+			// Entries still being stored by another build are not complete yet
+			if (!bIsDirectory || FString(FilenameOrDirectory).EndsWith(TEXT(".tmp")))
+			{
+				return true;
+			}
+
+			FCacheEntry& Entry = Entries.AddDefaulted_GetRef();
+			Entry.Dir = FilenameOrDirectory;
+			Entry.LastUsed = FileManager.GetTimeStamp(*(Entry.Dir / LastUsedFileName));
+			FileManager.IterateDirectoryStat(FilenameOrDirectory, [&Entry](const TCHAR*, const FFileStatData& StatData)
+			{
+				Entry.Size += StatData.bIsDirectory ? 0 : StatData.FileSize;
+				return true;
+			});
+
+			TotalSize += Entry.Size;
+			return true;
+		});
+
+		if (TotalSize <= MaxBytes)
+		{
+			return;
+		}
+
+		Entries.Sort([](const FCacheEntry& A, const FCacheEntry& B) { return A.LastUsed < B.LastUsed; });
+
+		for (const FCacheEntry& Entry : Entries)
+		{
+			if (TotalSize <= MaxBytes)
+			{
+				break;
+			}
+
+			if (FPaths::GetCleanFilename(Entry.Dir) == KeepKey)
+			{
+				continue;
+			}
+
+			UE_LOG(LogModdingEx, Log, TEXT("Evicting build cache entry %s (%.1f MB)"), *FPaths::GetCleanFilename(Entry.Dir), Entry.Size / (1024.0 * 1024.0));
+			if (FileManager.DeleteDirectory(*Entry.Dir, false, true))
+			{
+				TotalSize -= Entry.Size;
+			}
+		}
+	}
+}
@@ -0,0 +1,176 @@
+﻿#include "Build/ModBuildManifest.h"
+
+#include "JsonObjectConverter.h"
+#include "ModdingEx.h"
+#include "Build/ModHash.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace ModBuildManifest
+{
+	FString GetManifestPath(const FString& ModName)
+	{
+		return FPaths::ProjectIntermediateDir() / TEXT("ModdingEx") / TEXT("BuildManifests") / (ModName + TEXT(".json"));
+	}
+
+	bool Load(const FString& ModName, FModBuildManifest& OutManifest)
+	{
+		FString JsonString;
+		if (!FFileHelper::LoadFileToString(JsonString, *GetManifestPath(ModName)))
+		{
+			return false;
+		}
+
+		return FJsonObjectConverter::JsonObjectStringToUStruct(JsonString, &OutManifest, 0, 0);
+	}
+
+	bool Save(const FString& ModName, const FModBuildManifest& Manifest)
+	{
+		FString JsonString;
+		if (!FJsonObjectConverter::UStructToJsonObjectString(Manifest, JsonString))
+		{
+			return false;
+		}
+
+		if (!FFileHelper::SaveStringToFile(JsonString, *GetManifestPath(ModName)))
+		{
+			UE_LOG(LogModdingEx, Warning, TEXT("Failed to save build manifest: %s"), *GetManifestPath(ModName));
+			return false;
+		}
+
+		return true;
+	}
+
+	void Delete(const FString& ModName)
+	{
+		IFileManager::Get().Delete(*GetManifestPath(ModName), false, true, true);
+	}
+
+	void CollectInputs(const FString& ModName, const TArray<FString>& ExternalFiles, const FModBuildManifest* Previous, TArray<FModBuildManifestFile>& OutInputs)
+	{
+		TMap<FString, const FModBuildManifestFile*> PreviousInputs;
+		if (Previous)
+		{
+			for (const FModBuildManifestFile& Input : Previous->Inputs)
+			{
+				PreviousInputs.Add(Input.Path, &Input);
+			}
+		}
+
+		const FString ProjectDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+		const FString ModContentDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir() / TEXT("Mods") / ModName);
+
+		OutInputs.Empty();
+		auto AddInput = [&](const TCHAR* FilenameOrDirectory, const FFileStatData& StatData)
+		{
+			if (StatData.bIsDirectory)
+			{
+				return true;
+			}
+
+			FModBuildManifestFile Input;
+			Input.Path = FilenameOrDirectory;
+			FPaths::MakePathRelativeTo(Input.Path, *ProjectDir);
+			Input.Size = StatData.FileSize;
+			Input.Timestamp = LexToString(StatData.ModificationTime.GetTicks());
+
+			// Untouched files keep their hash, only files with a new size or timestamp are read
+			const FModBuildManifestFile* const* PreviousInput = PreviousInputs.Find(Input.Path);
+			if (PreviousInput && (*PreviousInput)->Size == Input.Size && (*PreviousInput)->Timestamp == Input.Timestamp)
+			{
+				Input.Hash = (*PreviousInput)->Hash;
+			}
+			else
+			{
+				FSHAHash Hash;
+				if (ModHash::HashFile(FilenameOrDirectory, Hash))
+				{
+					Input.Hash = Hash.ToString();
+				}
+			}
+
+			OutInputs.Add(MoveTemp(Input));
+			return true;
+		};
+
+		IFileManager::Get().IterateDirectoryStatRecursively(*ModContentDir, AddInput);
+
+		for (const FString& ExternalFile : ExternalFiles)
+		{
+			const FString FullPath = FPaths::ConvertRelativePathToFull(ExternalFile);
+			const FFileStatData StatData = IFileManager::Get().GetStatData(*FullPath);
+			if (StatData.bIsValid)
+			{
+				AddInput(*FullPath, StatData);
+			}
+			else
+			{
+				// Recorded without a hash, so the inputs never match and the cache key stays empty until the file is back
+				FModBuildManifestFile Input;
+				Input.Path = FullPath;
+				FPaths::MakePathRelativeTo(Input.Path, *ProjectDir);
+				Input.Size = -1;
+				OutInputs.Add(MoveTemp(Input));
+			}
+		}
+
+		OutInputs.Sort([](const FModBuildManifestFile& A, const FModBuildManifestFile& B) { return A.Path < B.Path; });
+	}
+
+	void CollectOutputs(const TArray<FString>& FilePaths, TArray<FModBuildManifestFile>& OutOutputs)
+	{
+		IFileManager& FileManager = IFileManager::Get();
+
+		OutOutputs.Empty();
+		for (const FString& FilePath : FilePaths)
+		{
+			const FFileStatData StatData = FileManager.GetStatData(*FilePath);
+
+			FModBuildManifestFile Output;
+			Output.Path = FilePath;
+			Output.Size = StatData.bIsValid ? StatData.FileSize : -1;
+			Output.Timestamp = LexToString(StatData.ModificationTime.GetTicks());
+			OutOutputs.Add(MoveTemp(Output));
+		}
+	}
+
+	bool AreOutputsDeployed(const FModBuildManifest& Manifest)
+	{
+		if (Manifest.Outputs.IsEmpty())
+		{
+			return false;
+		}
+
+		IFileManager& FileManager = IFileManager::Get();
+		for (const FModBuildManifestFile& Output : Manifest.Outputs)
+		{
+			const FFileStatData StatData = FileManager.GetStatData(*Output.Path);
+			if (!StatData.bIsValid || StatData.FileSize != Output.Size || LexToString(StatData.ModificationTime.GetTicks()) != Output.Timestamp)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool AreInputsEqual(const TArray<FModBuildManifestFile>& InputsA, const TArray<FModBuildManifestFile>& InputsB)
+	{
+		if (InputsA.Num() != InputsB.Num())
+		{
+			return false;
+		}
+
+		// Only path and content matter, a touched but unchanged asset doesn't need a rebuild
+		for (int32 Index = 0; Index < InputsA.Num(); Index++)
+		{
+			if (InputsA[Index].Path != InputsB[Index].Path || InputsA[Index].Hash.IsEmpty() || InputsA[Index].Hash != InputsB[Index].Hash)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
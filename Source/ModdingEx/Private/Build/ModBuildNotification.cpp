@@ -0,0 +1,88 @@
+﻿#include "Build/ModBuildNotification.h"
+
+#include "Async/Async.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+#define LOCTEXT_NAMESPACE "ModBuildNotification"
+
+FModBuildNotification::FModBuildNotification(const FText& Title, FSimpleDelegate OnCancel)
+{
+	check(IsInGameThread());
+
+	FNotificationInfo Info(Title);
+	Info.SubText = LOCTEXT("StartingUat", "Starting Unreal Automation Tool...");
+	Info.Image = FAppStyle::GetBrush(TEXT("LevelEditor.RecompileGameCode"));
+	Info.FadeInDuration = 0.1f;
+	Info.FadeOutDuration = 0.5f;
+	Info.ExpireDuration = 3.5f;
+	Info.bUseThrobber = true;
+	Info.bUseSuccessFailIcons = true;
+	Info.bFireAndForget = false;
+	Info.bAllowThrottleWhenFrameRateIsLow = false;
+
+	if (OnCancel.IsBound())
+	{
+		Info.ButtonDetails.Add(FNotificationButtonInfo(LOCTEXT("CancelBuild", "Cancel"), LOCTEXT("CancelBuildTooltip", "Stop the build, the deployed mod files are left as they are"),
+			OnCancel, SNotificationItem::CS_Pending));
+	}
+
+	Item = FSlateNotificationManager::Get().AddNotification(Info);
+	if (Item.IsValid())
+	{
+		Item->SetCompletionState(SNotificationItem::CS_Pending);
+	}
+}
+
+void FModBuildNotification::SetProgressText(const FString& Text)
+{
+	FScopeLock Lock(&PendingLock);
+	PendingText = Text;
+
+	if (bUpdateQueued)
+	{
+		return;
+	}
+
+	bUpdateQueued = true;
+	AsyncTask(ENamedThreads::GameThread, [WeakThis = AsWeak()]
+	{
+		if (const TSharedPtr<FModBuildNotification> This = WeakThis.Pin())
+		{
+			This->ApplyPendingText();
+		}
+	});
+}
+
+void FModBuildNotification::Complete(bool bSuccess, const FText& Text)
+{
+	check(IsInGameThread());
+
+	if (!Item.IsValid())
+	{
+		return;
+	}
+
+	Item->SetText(Text);
+	Item->SetSubText(FText::GetEmpty());
+	Item->SetCompletionState(bSuccess ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+	Item->ExpireAndFadeout();
+	Item.Reset();
+}
+
+void FModBuildNotification::ApplyPendingText()
+{
+	FString Text;
+	{
+		FScopeLock Lock(&PendingLock);
+		Text = MoveTemp(PendingText);
+		bUpdateQueued = false;
+	}
+
+	if (Item.IsValid())
+	{
+		Item->SetSubText(FText::FromString(Text));
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
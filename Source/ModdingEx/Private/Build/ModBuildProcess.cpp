@@ -0,0 +1,127 @@
+﻿#include "Build/ModBuildProcess.h"
+
+#include "ModdingEx.h"
+
+FModBuildProcess::FModBuildProcess(FString InExecutable, FString InParams) : Executable(MoveTemp(InExecutable)),
+                                                                             Params(MoveTemp(InParams))
+{
+}
+
+bool FModBuildProcess::Run(int32& OutReturnCode)
+{
+	void* ReadPipe = nullptr;
+	void* WritePipe = nullptr;
+	if (!FPlatformProcess::CreatePipe(ReadPipe, WritePipe))
+	{
+		UE_LOG(LogModdingEx, Error, TEXT("Failed to create output pipe for %s"), *Executable);
+		return false;
+	}
+
+	uint32 ProcessId = 0;
+	FProcHandle ProcessHandle;
+	{
+		// CreateProc has no environment parameter, the child inherits the editor's. So the variables are set just for the start
+		// and restored right after, under a lock so two builds starting at once don't restore each other's values
+		static FCriticalSection EnvironmentLock;
+		FScopeLock ScopeLock(&EnvironmentLock);
+
+		TMap<FString, FString> PreviousEnvironment;
+		for (const TPair<FString, FString>& Variable : Environment)
+		{
+			PreviousEnvironment.Add(Variable.Key, FPlatformMisc::GetEnvironmentVariable(*Variable.Key));
+			FPlatformMisc::SetEnvironmentVar(*Variable.Key, *Variable.Value);
+		}
+
+		ProcessHandle = FPlatformProcess::CreateProc(*Executable, *Params, false, true, true, &ProcessId, 0,
+		                                             nullptr, WritePipe, nullptr);
+
+		for (const TPair<FString, FString>& Variable : PreviousEnvironment)
+		{
+			FPlatformMisc::SetEnvironmentVar(*Variable.Key, *Variable.Value);
+		}
+	}
+	if (!ProcessHandle.IsValid())
+	{
+		UE_LOG(LogModdingEx, Error, TEXT("Failed to start %s"), *Executable);
+		FPlatformProcess::ClosePipe(ReadPipe, WritePipe);
+		return false;
+	}
+
+	FString PendingOutput;
+	while (FPlatformProcess::IsProcRunning(ProcessHandle))
+	{
+		PendingOutput += FPlatformProcess::ReadPipe(ReadPipe);
+		EmitLines(PendingOutput, false);
+
+		// UAT runs UBT and the cooker as child processes, killing only UAT would leave them running
+		if (ShouldCancel && ShouldCancel())
+		{
+			UE_LOG(LogModdingEx, Log, TEXT("Cancelling %s"), *FPaths::GetCleanFilename(Executable));
+			FPlatformProcess::TerminateProc(ProcessHandle, true);
+			FPlatformProcess::WaitForProc(ProcessHandle);
+			bCancelled = true;
+			break;
+		}
+
+		FPlatformProcess::Sleep(0.01f);
+	}
+
+	// The process may have written more output between the last read and exiting
+	PendingOutput += FPlatformProcess::ReadPipe(ReadPipe);
+	EmitLines(PendingOutput, true);
+
+	OutReturnCode = -1;
+	FPlatformProcess::GetProcReturnCode(ProcessHandle, &OutReturnCode);
+	FPlatformProcess::CloseProc(ProcessHandle);
+	FPlatformProcess::ClosePipe(ReadPipe, WritePipe);
+
+	return true;
+}
+
+FString FModBuildProcess::GetLastLine() const
+{
+	FScopeLock Lock(&LastLineLock);
+	return LastLine;
+}
+
+void FModBuildProcess::EmitLines(FString& Buffer, bool bFlush)
+{
+	int32 NewLineIndex;
+	while (Buffer.FindChar(TEXT('\n'), NewLineIndex))
+	{
+		FString Line = Buffer.Left(NewLineIndex);
+		Buffer.RightChopInline(NewLineIndex + 1, false);
+		Line.TrimEndInline();
+
+		if (Line.IsEmpty())
+		{
+			continue;
+		}
+
+		{
+			FScopeLock Lock(&LastLineLock);
+			LastLine = Line;
+		}
+
+		if (OnOutput)
+		{
+			OnOutput(Line);
+		}
+	}
+
+	if (bFlush && !Buffer.TrimEnd().IsEmpty())
+	{
+		FString Line = Buffer.TrimEnd();
+		Buffer.Empty();
+
+		{
+			FScopeLock Lock(&LastLineLock);
+			LastLine = Line;
+		}
+
+		if (OnOutput)
+		{
+			OnOutput(Line);
+		}
+	}
+}
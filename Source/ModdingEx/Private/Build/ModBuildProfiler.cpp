@@ -0,0 +1,237 @@
+#include "Build/ModBuildProfiler.h"
+
+#include "ModdingEx.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+const TCHAR* LexToString(EModBuildPhase Phase)
+{
+	switch (Phase)
+	{
+	case EModBuildPhase::SavePackages: return TEXT("SavePackages");
+	case EModBuildPhase::Uat: return TEXT("Uat");
+	case EModBuildPhase::Compile: return TEXT("Compile");
+	case EModBuildPhase::Cook: return TEXT("Cook");
+	case EModBuildPhase::Stage: return TEXT("Stage");
+	case EModBuildPhase::Pak: return TEXT("Pak");
+	case EModBuildPhase::IoStore: return TEXT("IoStore");
+	case EModBuildPhase::Package: return TEXT("Package");
+	case EModBuildPhase::Copy: return TEXT("Copy");
+	case EModBuildPhase::Zip: return TEXT("Zip");
+	default: return TEXT("Unknown");
+	}
+}
+
+FModBuildProfiler::FModBuildProfiler()
+{
+	StartTime = FPlatformTime::Seconds();
+}
+
+void FModBuildProfiler::BeginPhase(EModBuildPhase Phase)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const double Now = FPlatformTime::Seconds();
+	EndPhaseLocked(Now);
+
+	CurrentPhase = Phase;
+	PhaseStartTime = Now;
+	SampleMemoryLocked();
+}
+
+void FModBuildProfiler::EndPhase()
+{
+	FScopeLock ScopeLock(&Lock);
+	EndPhaseLocked(FPlatformTime::Seconds());
+}
+
+void FModBuildProfiler::ProcessUatLine(const FString& Line)
+{
+	// BuildCookRun prints "********** COOK COMMAND STARTED **********" and the same with COMPLETED around every command
+	if (Line.Contains(TEXT("**********")))
+	{
+		static const TPair<const TCHAR*, EModBuildPhase> Commands[] = {
+			{ TEXT("BUILD COMMAND"), EModBuildPhase::Compile },
+			{ TEXT("COOK COMMAND"), EModBuildPhase::Cook },
+			{ TEXT("STAGE COMMAND"), EModBuildPhase::Stage },
+			{ TEXT("PACKAGE COMMAND"), EModBuildPhase::Package },
+		};
+
+		for (const TPair<const TCHAR*, EModBuildPhase>& Command : Commands)
+		{
+			if (Line.Contains(Command.Key))
+			{
+				BeginPhase(Line.Contains(TEXT("STARTED")) ? Command.Value : EModBuildPhase::Uat);
+				return;
+			}
+		}
+	}
+
+	// Paks and IoStore containers are written by UnrealPak while staging
+	if (Line.Contains(TEXT("Running:")) && Line.Contains(TEXT("UnrealPak")))
+	{
+		BeginPhase(Line.Contains(TEXT("-CreateGlobalContainer")) || Line.Contains(TEXT("IoStore")) ? EModBuildPhase::IoStore : EModBuildPhase::Pak);
+		return;
+	}
+
+	SampleMemory();
+}
+
+void FModBuildProfiler::SampleMemory()
+{
+	FScopeLock ScopeLock(&Lock);
+	SampleMemoryLocked();
+}
+
+TOptional<EModBuildPhase> FModBuildProfiler::GetCurrentPhase() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return CurrentPhase;
+}
+
+double FModBuildProfiler::GetElapsedSeconds() const
+{
+	return FPlatformTime::Seconds() - StartTime;
+}
+
+void FModBuildProfiler::Finish(FModBuildRecord& OutRecord)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const double Now = FPlatformTime::Seconds();
+	EndPhaseLocked(Now);
+
+	OutRecord.TotalSeconds = Now - StartTime;
+	FMemory::Memcpy(OutRecord.PhaseSeconds, PhaseSeconds, sizeof(PhaseSeconds));
+	FMemory::Memcpy(OutRecord.PhasePeakMemoryMB, PhasePeakMemoryMB, sizeof(PhasePeakMemoryMB));
+}
+
+void FModBuildProfiler::EndPhaseLocked(double Now)
+{
+	if (CurrentPhase.IsSet())
+	{
+		SampleMemoryLocked();
+		PhaseSeconds[(int32)CurrentPhase.GetValue()] += Now - PhaseStartTime;
+		CurrentPhase.Reset();
+	}
+}
+
+void FModBuildProfiler::SampleMemoryLocked()
+{
+	if (!CurrentPhase.IsSet())
+	{
+		return;
+	}
+
+	const FPlatformMemoryStats Stats = FPlatformMemory::GetStats();
+	const double UsedMB = (Stats.TotalPhysical - Stats.AvailablePhysical) / (1024.0 * 1024.0);
+
+	double& Peak = PhasePeakMemoryMB[(int32)CurrentPhase.GetValue()];
+	Peak = FMath::Max(Peak, UsedMB);
+}
+
+namespace ModBuildHistory
+{
+	constexpr int32 FixedColumns = 8;
+
+	FString GetHistoryPath()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("ModdingEx") / TEXT("BuildHistory.csv");
+	}
+
+	FString MakeHeader()
+	{
+		FString Header = TEXT("Time,Mod,Result,EngineVersion,SettingsHash,InputFiles,InputBytes,TotalSeconds");
+		for (int32 Phase = 0; Phase < (int32)EModBuildPhase::Num; Phase++)
+		{
+			Header += FString::Printf(TEXT(",%sSeconds,%sPeakMB"), LexToString((EModBuildPhase)Phase), LexToString((EModBuildPhase)Phase));
+		}
+		return Header;
+	}
+
+	// Commas would shift the columns
+	FString Escape(const FString& Value)
+	{
+		return Value.Replace(TEXT(","), TEXT("_"));
+	}
+
+	void Append(const FModBuildRecord& Record)
+	{
+		const FString HistoryPath = GetHistoryPath();
+
+		FString Line;
+		if (!FPaths::FileExists(HistoryPath))
+		{
+			Line = MakeHeader() + LINE_TERMINATOR;
+		}
+
+		Line += FString::Printf(TEXT("%s,%s,%s,%s,%s,%d,%lld,%.2f"), *Record.Time.ToIso8601(), *Escape(Record.ModName), *Escape(Record.Result),
+			*Escape(Record.EngineVersion), *Record.SettingsHash, Record.InputFiles, Record.InputBytes, Record.TotalSeconds);
+		for (int32 Phase = 0; Phase < (int32)EModBuildPhase::Num; Phase++)
+		{
+			Line += FString::Printf(TEXT(",%.2f,%.0f"), Record.PhaseSeconds[Phase], Record.PhasePeakMemoryMB[Phase]);
+		}
+		Line += LINE_TERMINATOR;
+
+		if (!FFileHelper::SaveStringToFile(Line, *HistoryPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+		{
+			UE_LOG(LogModdingEx, Warning, TEXT("Failed to write build history: %s"), *HistoryPath);
+		}
+	}
+
+	void Load(TArray<FModBuildRecord>& OutRecords)
+	{
+		OutRecords.Empty();
+
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *GetHistoryPath()))
+		{
+			return;
+		}
+
+		// Columns are looked up by the header, so histories written before a phase was added still load
+		TArray<FString> Header;
+		if (Lines.IsEmpty())
+		{
+			return;
+		}
+		Lines[0].ParseIntoArray(Header, TEXT(","), false);
+
+		for (int32 LineIndex = 1; LineIndex < Lines.Num(); LineIndex++)
+		{
+			TArray<FString> Values;
+			Lines[LineIndex].ParseIntoArray(Values, TEXT(","), false);
+			if (Values.Num() < FixedColumns)
+			{
+				continue;
+			}
+
+			FModBuildRecord& Record = OutRecords.AddDefaulted_GetRef();
+			FDateTime::ParseIso8601(*Values[0], Record.Time);
+			Record.ModName = Values[1];
+			Record.Result = Values[2];
+			Record.EngineVersion = Values[3];
+			Record.SettingsHash = Values[4];
+			LexFromString(Record.InputFiles, *Values[5]);
+			LexFromString(Record.InputBytes, *Values[6]);
+			LexFromString(Record.TotalSeconds, *Values[7]);
+
+			for (int32 Column = FixedColumns; Column < FMath::Min(Header.Num(), Values.Num()); Column++)
+			{
+				for (int32 Phase = 0; Phase < (int32)EModBuildPhase::Num; Phase++)
+				{
+					const FString PhaseName = LexToString((EModBuildPhase)Phase);
+					if (Header[Column] == PhaseName + TEXT("Seconds"))
+					{
+						LexFromString(Record.PhaseSeconds[Phase], *Values[Column]);
+					}
+					else if (Header[Column] == PhaseName + TEXT("PeakMB"))
+					{
+						LexFromString(Record.PhasePeakMemoryMB[Phase], *Values[Column]);
+					}
+				}
+			}
+		}
+	}
+}
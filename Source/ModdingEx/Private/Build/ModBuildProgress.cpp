@@ -0,0 +1,235 @@
+#include "Build/ModBuildProgress.h"
+
+#include "HAL/FileManager.h"
+#include "Internationalization/Regex.h"
+
+void FModBuildProgress::Start(const FString& InStagingDir, const TOptional<FModBuildRecord>& InPreviousRecord)
+{
+	FScopeLock ScopeLock(&Lock);
+	StagingDir = InStagingDir;
+	PreviousRecord = InPreviousRecord;
+}
+
+void FModBuildProgress::ProcessLine(const FString& Line)
+{
+	// The IoStore commandlet prints "Hashing: 10/40, Compressing: 8/40, Serializing: 5/40" while writing the containers,
+	// serializing is the last step. UnrealPak prints no count of its own, its progress comes from the size of the pak being written
+	if (Line.Contains(TEXT("LogPakFile")))
+	{
+		return;
+	}
+
+	if (Line.Contains(TEXT("LogIoStore")))
+	{
+		static const FRegexPattern SerializingPattern(TEXT("Serializing: (\\d+)/(\\d+)"));
+		FRegexMatcher Matcher(SerializingPattern, Line);
+		if (Matcher.FindNext())
+		{
+			const int32 Done = FCString::Atoi(*Matcher.GetCaptureGroup(1));
+			const int32 Total = FCString::Atoi(*Matcher.GetCaptureGroup(2));
+			if (Total > 0 && Done <= Total)
+			{
+				FScopeLock ScopeLock(&Lock);
+				PackedItems = Done;
+				TotalPackItems = Total;
+			}
+		}
+		return;
+	}
+
+	// UE5 cookers print "Cooked packages 120 Packages Remain 380 Total 500" every few seconds
+	if (!Line.Contains(TEXT("Cooked packages")))
+	{
+		return;
+	}
+
+	static const FRegexPattern CookPattern(TEXT("Cooked packages (\\d+) Packages Remain (\\d+) Total (\\d+)"));
+	FRegexMatcher Matcher(CookPattern, Line);
+	if (!Matcher.FindNext())
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	CookedPackages = FCString::Atoi(*Matcher.GetCaptureGroup(1));
+	TotalPackages = FCString::Atoi(*Matcher.GetCaptureGroup(3));
+	LastCookSampleTime = FPlatformTime::Seconds();
+
+	if (FirstCookSampleTime == 0.0)
+	{
+		FirstCookSampleTime = LastCookSampleTime;
+		FirstCookedPackages = CookedPackages;
+	}
+}
+
+void FModBuildProgress::SetDetail(const FString& InDetail)
+{
+	FScopeLock ScopeLock(&Lock);
+	Detail = InDetail;
+}
+
+float FModBuildProgress::GetFraction(const FModBuildProfiler& Profiler) const
+{
+	const TOptional<double> Remaining = GetRemainingSeconds(Profiler);
+	if (Remaining.IsSet())
+	{
+		const double Elapsed = Profiler.GetElapsedSeconds();
+		return FMath::Clamp(Elapsed / FMath::Max(Elapsed + Remaining.GetValue(), 0.001), 0.0, 0.99);
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	const TOptional<EModBuildPhase> Phase = Profiler.GetCurrentPhase();
+	if (Phase == EModBuildPhase::Cook && TotalPackages > 0)
+	{
+		return (float)CookedPackages / TotalPackages;
+	}
+	if ((Phase == EModBuildPhase::Pak || Phase == EModBuildPhase::IoStore) && TotalPackItems > 0)
+	{
+		return (float)PackedItems / TotalPackItems;
+	}
+
+	return -1.0f;
+}
+
+FString FModBuildProgress::GetStatus(const FModBuildProfiler& Profiler) const
+{
+	const TOptional<EModBuildPhase> Phase = Profiler.GetCurrentPhase();
+	FString Status = Phase.IsSet() ? LexToString(Phase.GetValue()) : TEXT("Finishing");
+
+	if (Phase == EModBuildPhase::Pak || Phase == EModBuildPhase::IoStore || Phase == EModBuildPhase::Stage)
+	{
+		SampleOutputSize();
+	}
+
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (Phase == EModBuildPhase::Cook && TotalPackages > 0)
+		{
+			const double CookSeconds = LastCookSampleTime - FirstCookSampleTime;
+			const double PackagesPerSecond = CookSeconds > 0.0 ? (CookedPackages - FirstCookedPackages) / CookSeconds : 0.0;
+			Status += FString::Printf(TEXT(" %d/%d packages (%.1f/s)"), CookedPackages, TotalPackages, PackagesPerSecond);
+		}
+		else if (Phase == EModBuildPhase::Pak || Phase == EModBuildPhase::IoStore)
+		{
+			// The tools' own counts first, the growing output files only tell the size written so far
+			if (TotalPackItems > 0)
+			{
+				Status += FString::Printf(TEXT(" %d/%d"), PackedItems, TotalPackItems);
+			}
+			if (OutputBytes > 0)
+			{
+				Status += FString::Printf(TEXT(" %.1f MB (%.1f MB/s)"), OutputBytes / (1024.0 * 1024.0), OutputBytesPerSecond / (1024.0 * 1024.0));
+			}
+		}
+
+		if (!Detail.IsEmpty())
+		{
+			Status += TEXT(": ") + Detail;
+		}
+	}
+
+	const TOptional<double> Remaining = GetRemainingSeconds(Profiler);
+	if (!Remaining.IsSet())
+	{
+		Status += FString::Printf(TEXT(" - %s elapsed"), *FormatDuration(Profiler.GetElapsedSeconds()));
+	}
+	else if (Remaining.GetValue() >= 0.0)
+	{
+		Status += FString::Printf(TEXT(" - %s left"), *FormatDuration(Remaining.GetValue()));
+	}
+	else
+	{
+		// Still running past the estimate, which is what a hung build looks like
+		Status += FString::Printf(TEXT(" - %s longer than the last build"), *FormatDuration(-Remaining.GetValue()));
+	}
+
+	return Status;
+}
+
+TOptional<FModBuildRecord> FModBuildProgress::FindPreviousRecord(const FString& ModName)
+{
+	TArray<FModBuildRecord> Records;
+	ModBuildHistory::Load(Records);
+
+	for (int32 Index = Records.Num() - 1; Index >= 0; Index--)
+	{
+		if (Records[Index].ModName == ModName && Records[Index].Result == TEXT("Built"))
+		{
+			return Records[Index];
+		}
+	}
+
+	return {};
+}
+
+TOptional<double> FModBuildProgress::GetRemainingSeconds(const FModBuildProfiler& Profiler) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const double Elapsed = Profiler.GetElapsedSeconds();
+	const TOptional<EModBuildPhase> Phase = Profiler.GetCurrentPhase();
+
+	// While cooking the package rate is a better estimate than the last build, the phases after it still come from there
+	const double CookSeconds = LastCookSampleTime - FirstCookSampleTime;
+	if (Phase == EModBuildPhase::Cook && TotalPackages > 0 && CookSeconds > 0.0 && CookedPackages > FirstCookedPackages)
+	{
+		const double PackagesPerSecond = (CookedPackages - FirstCookedPackages) / CookSeconds;
+		double Remaining = (TotalPackages - CookedPackages) / PackagesPerSecond - (FPlatformTime::Seconds() - LastCookSampleTime);
+
+		if (PreviousRecord.IsSet())
+		{
+			for (int32 AfterCook = (int32)EModBuildPhase::Cook + 1; AfterCook < (int32)EModBuildPhase::Num; AfterCook++)
+			{
+				if ((EModBuildPhase)AfterCook != EModBuildPhase::Zip)
+				{
+					Remaining += PreviousRecord->PhaseSeconds[AfterCook];
+				}
+			}
+		}
+
+		return Remaining;
+	}
+
+	if (PreviousRecord.IsSet() && PreviousRecord->TotalSeconds > 0.0)
+	{
+		return PreviousRecord->TotalSeconds - Elapsed;
+	}
+
+	return {};
+}
+
+void FModBuildProgress::SampleOutputSize() const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const double Now = FPlatformTime::Seconds();
+	if (StagingDir.IsEmpty() || Now - LastOutputSampleTime < 1.0)
+	{
+		return;
+	}
+
+	int64 Bytes = 0;
+	IFileManager::Get().IterateDirectoryStatRecursively(*StagingDir, [&Bytes](const TCHAR* FilenameOrDirectory, const FFileStatData& StatData)
+	{
+		const FString Extension = FPaths::GetExtension(FilenameOrDirectory);
+		if (!StatData.bIsDirectory && (Extension == TEXT("pak") || Extension == TEXT("utoc") || Extension == TEXT("ucas")))
+		{
+			Bytes += StatData.FileSize;
+		}
+		return true;
+	});
+
+	if (LastOutputSampleTime > 0.0)
+	{
+		OutputBytesPerSecond = FMath::Max(0.0, (Bytes - OutputBytes) / (Now - LastOutputSampleTime));
+	}
+
+	OutputBytes = Bytes;
+	LastOutputSampleTime = Now;
+}
+
+FString FModBuildProgress::FormatDuration(double Seconds)
+{
+	const int32 TotalSeconds = FMath::RoundToInt(Seconds);
+	return FString::Printf(TEXT("%d:%02d"), TotalSeconds / 60, TotalSeconds % 60);
+}
@@ -0,0 +1,46 @@
+#include "Build/ModBuildReport.h"
+
+#include "JsonObjectConverter.h"
+#include "ModdingEx.h"
+#include "Build/ModHash.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+
+namespace ModBuildReport
+{
+	bool DescribeFile(const FString& FilePath, FModBuildReportFile& OutFile)
+	{
+		const FFileStatData StatData = IFileManager::Get().GetStatData(*FilePath);
+		if (!StatData.bIsValid || StatData.bIsDirectory)
+		{
+			return false;
+		}
+
+		OutFile.Path = FilePath;
+		OutFile.Size = StatData.FileSize;
+
+		FSHAHash Hash;
+		if (ModHash::HashFile(FilePath, Hash))
+		{
+			OutFile.Sha1 = Hash.ToString();
+		}
+		return true;
+	}
+
+	bool Save(const FString& ReportPath, const FModBuildReport& Report)
+	{
+		FString JsonString;
+		if (!FJsonObjectConverter::UStructToJsonObjectString(Report, JsonString))
+		{
+			return false;
+		}
+
+		if (!FFileHelper::SaveStringToFile(JsonString, *ReportPath))
+		{
+			UE_LOG(LogModdingEx, Error, TEXT("Failed to write build report: %s"), *ReportPath);
+			return false;
+		}
+
+		return true;
+	}
+}
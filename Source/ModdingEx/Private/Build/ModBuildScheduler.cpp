@@ -0,0 +1,256 @@
+#include "Build/ModBuildScheduler.h"
+
+#include "ModdingEx.h"
+#include "ModdingExSettings.h"
+#include "Algo/Count.h"
+#include "Build/ModBuildContext.h"
+#include "HAL/PlatformMemory.h"
+
+const TCHAR* LexToString(EModBuildQueueState State)
+{
+	switch (State)
+	{
+	case EModBuildQueueState::Queued: return TEXT("Queued");
+	case EModBuildQueueState::Building: return TEXT("Building");
+	case EModBuildQueueState::Built: return TEXT("Built");
+	case EModBuildQueueState::Unchanged: return TEXT("Unchanged");
+	case EModBuildQueueState::Failed: return TEXT("Failed");
+	case EModBuildQueueState::Cancelled: return TEXT("Cancelled");
+	default: return TEXT("Unknown");
+	}
+}
+
+FModBuildScheduler& FModBuildScheduler::Get()
+{
+	static FModBuildScheduler Scheduler;
+	return Scheduler;
+}
+
+void FModBuildScheduler::Enqueue(const TArray<FString>& ModNames, bool bForceRebuild)
+{
+	check(IsInGameThread());
+
+	if (IsIdle())
+	{
+		bFirstBuildFinished = false;
+	}
+
+	for (const FString& ModName : ModNames)
+	{
+		const bool bPending = Items.ContainsByPredicate([&ModName](const TSharedRef<FModBuildQueueItem>& Item)
+		{
+			return Item->ModName == ModName && !Item->IsFinished();
+		});
+		if (bPending)
+		{
+			UE_LOG(LogModdingEx, Log, TEXT("Mod '%s' is already in the build queue"), *ModName);
+			continue;
+		}
+
+		const TSharedRef<FModBuildQueueItem> Item = MakeShared<FModBuildQueueItem>();
+		Item->ModName = ModName;
+		Item->bForceRebuild = bForceRebuild;
+		Items.Add(Item);
+	}
+
+	UE_LOG(LogModdingEx, Log, TEXT("Build queue has %d mods, running up to %d at once"), Items.Num(), GetMaxConcurrency());
+
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FModBuildScheduler::Tick), 0.25f);
+	}
+
+	OnChanged.Broadcast();
+}
+
+void FModBuildScheduler::Cancel(const FString& ModName)
+{
+	check(IsInGameThread());
+
+	for (const TSharedRef<FModBuildQueueItem>& Item : Items)
+	{
+		if (Item->ModName != ModName)
+		{
+			continue;
+		}
+
+		if (Item->State == EModBuildQueueState::Queued)
+		{
+			Item->State = EModBuildQueueState::Cancelled;
+			Item->Result = EModBuildResult::Cancelled;
+		}
+		else if (Item->State == EModBuildQueueState::Building && Item->Context.IsValid())
+		{
+			// The item turns Cancelled once the build cleaned up after itself
+			UE_LOG(LogModdingEx, Log, TEXT("Cancelling the build of '%s'"), *ModName);
+			Item->Context->bCancelRequested = true;
+		}
+	}
+
+	OnChanged.Broadcast();
+}
+
+void FModBuildScheduler::CancelAll()
+{
+	for (const TSharedRef<FModBuildQueueItem>& Item : TArray<TSharedRef<FModBuildQueueItem>>(Items))
+	{
+		if (!Item->IsFinished())
+		{
+			Cancel(Item->ModName);
+		}
+	}
+}
+
+void FModBuildScheduler::ClearFinished()
+{
+	Items.RemoveAll([](const TSharedRef<FModBuildQueueItem>& Item) { return Item->IsFinished(); });
+	OnChanged.Broadcast();
+}
+
+void FModBuildScheduler::Shutdown()
+{
+	CancelAll();
+
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
+
+bool FModBuildScheduler::IsIdle() const
+{
+	return !Items.ContainsByPredicate([](const TSharedRef<FModBuildQueueItem>& Item) { return !Item->IsFinished(); });
+}
+
+int32 FModBuildScheduler::GetMaxConcurrency() const
+{
+	if (MaxConcurrencyOverride > 0)
+	{
+		return MaxConcurrencyOverride;
+	}
+
+	const UModdingExSettings* Settings = GetDefault<UModdingExSettings>();
+	if (Settings->MaxParallelBuilds > 0)
+	{
+		return Settings->MaxParallelBuilds;
+	}
+
+	// The editor itself keeps one cooker's worth of memory
+	const int32 ByCores = FPlatformMisc::NumberOfCoresIncludingHyperthreads() / FMath::Max(1, Settings->CoresPerBuild);
+	const int64 TotalMemoryMB = FPlatformMemory::GetStats().TotalPhysical / (1024 * 1024);
+	const int32 ByMemory = Settings->CookerMemoryMB > 0 ? (int32)(TotalMemoryMB / Settings->CookerMemoryMB) - 1 : ByCores;
+
+	return FMath::Max(1, FMath::Min(ByCores, ByMemory));
+}
+
+int64 FModBuildScheduler::GetAvailableMemoryMB()
+{
+	return FPlatformMemory::GetStats().AvailablePhysical / (1024 * 1024);
+}
+
+int32 FModBuildScheduler::GetNumBuilding() const
+{
+	return Algo::CountIf(Items, [](const TSharedRef<FModBuildQueueItem>& Item) { return Item->State == EModBuildQueueState::Building; });
+}
+
+bool FModBuildScheduler::Tick(float DeltaTime)
+{
+	bool bChanged = false;
+
+	for (const TSharedRef<FModBuildQueueItem>& Item : TArray<TSharedRef<FModBuildQueueItem>>(Items))
+	{
+		if (Item->State != EModBuildQueueState::Building || !Item->Future.IsReady())
+		{
+			continue;
+		}
+
+		Item->Result = Item->Future.Get();
+		Item->EndTime = FPlatformTime::Seconds();
+		bFirstBuildFinished = true;
+		bChanged = true;
+
+		UE_LOG(LogModdingEx, Log, TEXT("Queued build of '%s' finished after %.1fs: %s"), *Item->ModName, Item->EndTime - Item->StartTime,
+			*StaticEnum<EModBuildResult>()->GetNameStringByValue((int64)Item->Result));
+
+		OnBuildFinished.Broadcast(*Item);
+
+		switch (Item->Result)
+		{
+		case EModBuildResult::Built:
+			Item->State = EModBuildQueueState::Built;
+			break;
+		case EModBuildResult::ContentUnchanged:
+			Item->State = EModBuildQueueState::Unchanged;
+			break;
+		case EModBuildResult::Cancelled:
+			Item->State = EModBuildQueueState::Cancelled;
+			break;
+		default:
+			Item->State = EModBuildQueueState::Failed;
+			break;
+		}
+	}
+
+	const int32 NumBuilding = GetNumBuilding();
+	StartBuilds();
+	bChanged |= GetNumBuilding() != NumBuilding;
+
+	if (bChanged)
+	{
+		OnChanged.Broadcast();
+	}
+
+	if (IsIdle())
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FModBuildScheduler::StartBuilds()
+{
+	const UModdingExSettings* Settings = GetDefault<UModdingExSettings>();
+
+	// Only the first build compiles the game target, the ones after it find it up to date and can run side by side
+	const bool bMayBuildCode = Settings->CodeBuild != EModCodeBuild::Never;
+	const int32 MaxConcurrency = bFirstBuildFinished || !bMayBuildCode ? GetMaxConcurrency() : 1;
+
+	int32 NumBuilding = GetNumBuilding();
+	for (const TSharedRef<FModBuildQueueItem>& Item : Items)
+	{
+		if (NumBuilding >= MaxConcurrency)
+		{
+			break;
+		}
+
+		if (Item->State != EModBuildQueueState::Queued)
+		{
+			continue;
+		}
+
+		// The running cookers are still growing, another one only fits while there's room for it
+		if (NumBuilding > 0 && GetAvailableMemoryMB() < Settings->CookerMemoryMB)
+		{
+			UE_LOG(LogModdingEx, Verbose, TEXT("Holding back '%s', only %lld MB of memory are free"), *Item->ModName, GetAvailableMemoryMB());
+			break;
+		}
+
+		// Started from the menu or the watcher, picked up again once that build is done
+		if (UModBuilder::IsModBuilding(Item->ModName))
+		{
+			continue;
+		}
+
+		Item->Context = MakeShared<FModBuildContext>(Item->ModName, Settings->bShouldCheckHash);
+		Item->Context->PlatformName = PlatformName;
+		Item->Context->bForceRebuild = Item->bForceRebuild;
+		Item->StartTime = FPlatformTime::Seconds();
+		Item->State = EModBuildQueueState::Building;
+
+		UE_LOG(LogModdingEx, Display, TEXT("Starting queued build of '%s' (%d running)"), *Item->ModName, NumBuilding + 1);
+		Item->Future = UModBuilder::BuildModAsync(Item->Context.ToSharedRef());
+		NumBuilding++;
+	}
+}
@@ -0,0 +1,151 @@
+#include "Build/ModChunks.h"
+
+#include "ModdingEx.h"
+#include "ModdingExSettings.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/PrimaryAssetLabel.h"
+#include "Misc/PackageName.h"
+#include "UObject/SavePackage.h"
+
+namespace ModChunks
+{
+	/**
+	 * Chunk IDs other mods use, from the labels checked into the project and from ModChunkIds.
+	 * ModChunkIds is per user, on a fresh clone only the labels know which IDs are taken
+	 */
+	TMap<int32, FString> CollectUsedChunkIds(const FString& ModName, const TMap<FString, int32>& ChunkIds)
+	{
+		TMap<int32, FString> UsedChunkIds;
+
+		const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+		const FString ModPath = TEXT("/Game/Mods/") + ModName + TEXT("/");
+
+		TArray<FAssetData> Labels;
+		AssetRegistry.GetAssetsByClass(UPrimaryAssetLabel::StaticClass()->GetClassPathName(), Labels, true);
+		for (const FAssetData& Asset : Labels)
+		{
+			const FString PackageName = Asset.PackageName.ToString();
+			if (PackageName.StartsWith(ModPath))
+			{
+				continue;
+			}
+
+			// Labels are tiny, the rules aren't searchable tags so the asset has to be loaded
+			const UPrimaryAssetLabel* Label = Cast<UPrimaryAssetLabel>(Asset.GetAsset());
+			if (Label && Label->Rules.ChunkId > 0)
+			{
+				UsedChunkIds.Add(Label->Rules.ChunkId, PackageName);
+			}
+		}
+
+		for (const TPair<FString, int32>& Pair : ChunkIds)
+		{
+			if (Pair.Key != ModName && !UsedChunkIds.Contains(Pair.Value))
+			{
+				UsedChunkIds.Add(Pair.Value, Pair.Key);
+			}
+		}
+
+		return UsedChunkIds;
+	}
+
+	int32 GetNextFreeChunkId(const TMap<int32, FString>& UsedChunkIds)
+	{
+		int32 ChunkId = FirstModChunkId;
+		for (const TPair<int32, FString>& Pair : UsedChunkIds)
+		{
+			ChunkId = FMath::Max(ChunkId, Pair.Key + 1);
+		}
+		return ChunkId;
+	}
+
+	UPrimaryAssetLabel* FindLabel(const FString& ModName)
+	{
+		const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+		TArray<FAssetData> Labels;
+		AssetRegistry.GetAssetsByPath(*(TEXT("/Game/Mods/") + ModName), Labels, true);
+		for (const FAssetData& Asset : Labels)
+		{
+			if (Asset.IsInstanceOf(UPrimaryAssetLabel::StaticClass()))
+			{
+				return Cast<UPrimaryAssetLabel>(Asset.GetAsset());
+			}
+		}
+
+		return nullptr;
+	}
+
+	bool CreateLabel(const FString& ModName, int32 ChunkId)
+	{
+		const FString AssetName = ModName + TEXT("_ChunkLabel");
+		const FString PackageName = TEXT("/Game/Mods/") + ModName / AssetName;
+
+		UPackage* Package = CreatePackage(*PackageName);
+		UPrimaryAssetLabel* Label = NewObject<UPrimaryAssetLabel>(Package, *AssetName, RF_Public | RF_Standalone);
+		Label->bLabelAssetsInMyDirectory = true;
+		Label->Rules.ChunkId = ChunkId;
+		Label->Rules.CookRule = EPrimaryAssetCookRule::AlwaysCook;
+		FAssetRegistryModule::AssetCreated(Label);
+		Package->MarkPackageDirty();
+
+		const FString Filename = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		if (!UPackage::SavePackage(Package, Label, *Filename, SaveArgs))
+		{
+			UE_LOG(LogModdingEx, Error, TEXT("Failed to save chunk label: %s"), *Filename);
+			return false;
+		}
+
+		UE_LOG(LogModdingEx, Log, TEXT("Created chunk label '%s' with chunk %d"), *PackageName, ChunkId);
+		return true;
+	}
+
+	bool ResolveChunkId(const FString& ModName, int32& OutChunkId)
+	{
+		check(IsInGameThread());
+
+		UModdingExSettings* Settings = GetMutableDefault<UModdingExSettings>();
+		const TMap<int32, FString> UsedChunkIds = CollectUsedChunkIds(ModName, Settings->ModChunkIds);
+
+		// Checked before anything is saved, a colliding label or setting would stay behind after the build is rejected
+		auto IsChunkIdFree = [&UsedChunkIds, &ModName](int32 ChunkId)
+		{
+			if (const FString* Owner = UsedChunkIds.Find(ChunkId))
+			{
+				UE_LOG(LogModdingEx, Error, TEXT("Chunk %d of '%s' is already used by %s, change the chunk of one of them"), ChunkId, *ModName, **Owner);
+				return false;
+			}
+			return true;
+		};
+
+		const UPrimaryAssetLabel* ExistingLabel = FindLabel(ModName);
+		if (ExistingLabel && ExistingLabel->Rules.ChunkId > 0)
+		{
+			OutChunkId = ExistingLabel->Rules.ChunkId;
+			if (!IsChunkIdFree(OutChunkId))
+			{
+				return false;
+			}
+		}
+		else
+		{
+			const int32* StoredChunkId = Settings->ModChunkIds.Find(ModName);
+			OutChunkId = StoredChunkId ? *StoredChunkId : GetNextFreeChunkId(UsedChunkIds);
+			if (!IsChunkIdFree(OutChunkId) || !CreateLabel(ModName, OutChunkId))
+			{
+				return false;
+			}
+		}
+
+		const int32* StoredChunkId = Settings->ModChunkIds.Find(ModName);
+		if (!StoredChunkId || *StoredChunkId != OutChunkId)
+		{
+			Settings->ModChunkIds.Add(ModName, OutChunkId);
+			Settings->SaveConfig();
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,84 @@
+#include "Build/ModCookSet.h"
+
+#include "ModdingEx.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+
+namespace ModCookSet
+{
+	bool IsGamePackage(const FString& PackageName)
+	{
+		return !PackageName.StartsWith(TEXT("/Script/")) && !PackageName.StartsWith(TEXT("/Engine/"));
+	}
+
+	bool Collect(const FString& ModName, FModCookSet& OutCookSet)
+	{
+		const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+		if (AssetRegistry.IsLoadingAssets())
+		{
+			UE_LOG(LogModdingEx, Warning, TEXT("Asset Registry is still scanning, can't resolve the cook set of '%s'"), *ModName);
+			return false;
+		}
+
+		const FString ModPath = TEXT("/Game/Mods/") + ModName;
+		const FString ModPathPrefix = ModPath + TEXT("/");
+
+		TArray<FAssetData> ModAssets;
+		AssetRegistry.GetAssetsByPath(*ModPath, ModAssets, true);
+		if (ModAssets.IsEmpty())
+		{
+			UE_LOG(LogModdingEx, Warning, TEXT("No assets found in '%s'"), *ModPath);
+			return false;
+		}
+
+		// The ModActor is what the game loads, it is in the mod folder but listed first so it is never missed
+		TArray<FName> Pending;
+		Pending.Add(*(ModPathPrefix + TEXT("ModActor")));
+		for (const FAssetData& Asset : ModAssets)
+		{
+			Pending.Add(Asset.PackageName);
+		}
+
+		TSet<FName> Visited;
+		TArray<FName> Dependencies;
+		TArray<FAssetData> PackageAssets;
+		while (!Pending.IsEmpty())
+		{
+			const FName PackageName = Pending.Pop(false);
+			bool bAlreadyVisited;
+			Visited.Add(PackageName, &bAlreadyVisited);
+			if (bAlreadyVisited)
+			{
+				continue;
+			}
+
+			const FString PackageNameString = PackageName.ToString();
+			if (!IsGamePackage(PackageNameString))
+			{
+				continue;
+			}
+
+			// Only packages that exist on disk can be cooked, this also drops dangling references
+			PackageAssets.Reset();
+			AssetRegistry.GetAssetsByPackageName(PackageName, PackageAssets, true);
+			if (PackageAssets.IsEmpty())
+			{
+				continue;
+			}
+
+			OutCookSet.Packages.AddUnique(PackageName);
+			if (!PackageNameString.StartsWith(ModPathPrefix))
+			{
+				OutCookSet.ExternalPackages.AddUnique(PackageName);
+			}
+
+			// Editor only references are not cooked
+			Dependencies.Reset();
+			AssetRegistry.GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Game);
+			Pending.Append(Dependencies);
+		}
+
+		OutCookSet.Packages.Sort(FNameLexicalLess());
+		OutCookSet.ExternalPackages.Sort(FNameLexicalLess());
+		return true;
+	}
+}
@@ -0,0 +1,387 @@
+#include "Build/ModDeploy.h"
+
+#include "ModdingEx.h"
+#include "HAL/PlatformFileManager.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <winioctl.h>
+#include <RestartManager.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#endif
+
+const TCHAR* LexToString(EModDeployMethod Method)
+{
+	switch (Method)
+	{
+	case EModDeployMethod::Rename: return TEXT("Rename");
+	case EModDeployMethod::Reflink: return TEXT("Reflink");
+	case EModDeployMethod::Copy: return TEXT("Copy");
+	default: return TEXT("Unknown");
+	}
+}
+
+namespace ModDeploy
+{
+	constexpr int64 CopyChunkSize = 8 * 1024 * 1024;
+
+	// Clone the extents of the source into the destination, no data is copied. Only ReFS and Dev Drive volumes support this,
+	// and only within one volume. Unlike a hardlink both files stay independent, writing one never changes the other
+	bool TryReflink(const FString& SourcePath, const FString& DestPath)
+	{
+#if PLATFORM_WINDOWS
+		const FString FullSourcePath = FPaths::ConvertRelativePathToFull(SourcePath);
+		const FString FullDestPath = FPaths::ConvertRelativePathToFull(DestPath);
+
+		HANDLE SourceHandle = CreateFileW(*FullSourcePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (SourceHandle == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		DWORD FileSystemFlags = 0;
+		LARGE_INTEGER FileSize;
+		if (!GetVolumeInformationByHandleW(SourceHandle, nullptr, 0, nullptr, nullptr, &FileSystemFlags, nullptr, 0) ||
+			!(FileSystemFlags & FILE_SUPPORTS_BLOCK_REFCOUNTING) || !GetFileSizeEx(SourceHandle, &FileSize))
+		{
+			CloseHandle(SourceHandle);
+			return false;
+		}
+
+		// Cloned ranges have to be cluster aligned
+		WCHAR VolumePath[MAX_PATH];
+		DWORD SectorsPerCluster = 0, BytesPerSector = 0, FreeClusters = 0, TotalClusters = 0;
+		if (!GetVolumePathNameW(*FullSourcePath, VolumePath, MAX_PATH) ||
+			!GetDiskFreeSpaceW(VolumePath, &SectorsPerCluster, &BytesPerSector, &FreeClusters, &TotalClusters))
+		{
+			CloseHandle(SourceHandle);
+			return false;
+		}
+
+		HANDLE DestHandle = CreateFileW(*FullDestPath, GENERIC_READ | GENERIC_WRITE | DELETE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (DestHandle == INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(SourceHandle);
+			return false;
+		}
+
+		FILE_END_OF_FILE_INFO EndOfFile;
+		EndOfFile.EndOfFile = FileSize;
+		bool bSuccess = SetFileInformationByHandle(DestHandle, FileEndOfFileInfo, &EndOfFile, sizeof(EndOfFile)) != 0;
+
+		const int64 ClusterSize = (int64)SectorsPerCluster * BytesPerSector;
+		const int64 AlignedSize = Align(FileSize.QuadPart, ClusterSize);
+		const int64 MaxCloneSize = Align(1024ll * 1024 * 1024, ClusterSize);
+
+		for (int64 Offset = 0; bSuccess && Offset < AlignedSize; Offset += MaxCloneSize)
+		{
+			DUPLICATE_EXTENTS_DATA Extents;
+			Extents.FileHandle = SourceHandle;
+			Extents.SourceFileOffset.QuadPart = Offset;
+			Extents.TargetFileOffset.QuadPart = Offset;
+			Extents.ByteCount.QuadPart = FMath::Min(MaxCloneSize, AlignedSize - Offset);
+
+			DWORD BytesReturned = 0;
+			bSuccess = DeviceIoControl(DestHandle, FSCTL_DUPLICATE_EXTENTS_TO_FILE, &Extents, sizeof(Extents), nullptr, 0, &BytesReturned, nullptr) != 0;
+		}
+
+		if (!bSuccess)
+		{
+			FILE_DISPOSITION_INFO Disposition;
+			Disposition.DeleteFile = TRUE;
+			SetFileInformationByHandle(DestHandle, FileDispositionInfo, &Disposition, sizeof(Disposition));
+		}
+
+		CloseHandle(DestHandle);
+		CloseHandle(SourceHandle);
+		return bSuccess;
+#else
+		return false;
+#endif
+	}
+
+	bool CopyFileChunked(const FString& SourcePath, const FString& DestPath)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+		const TUniquePtr<IFileHandle> SourceHandle(PlatformFile.OpenRead(*SourcePath));
+		if (!SourceHandle)
+		{
+			return false;
+		}
+
+		TUniquePtr<IFileHandle> DestHandle(PlatformFile.OpenWrite(*DestPath));
+		if (!DestHandle)
+		{
+			return false;
+		}
+
+		TArray<uint8> Buffer;
+		Buffer.SetNumUninitialized(CopyChunkSize);
+
+		int64 Remaining = SourceHandle->Size();
+		while (Remaining > 0)
+		{
+			const int64 ChunkSize = FMath::Min(Remaining, CopyChunkSize);
+			if (!SourceHandle->Read(Buffer.GetData(), ChunkSize) || !DestHandle->Write(Buffer.GetData(), ChunkSize))
+			{
+				DestHandle.Reset();
+				PlatformFile.DeleteFile(*DestPath);
+				return false;
+			}
+			Remaining -= ChunkSize;
+		}
+
+		return DestHandle->Flush();
+	}
+
+	void FindLockHolders(const TArray<FString>& FilePaths, TArray<FModDeployLockHolder>& OutHolders)
+	{
+		OutHolders.Empty();
+
+#if PLATFORM_WINDOWS
+		DWORD Session;
+		WCHAR SessionKey[CCH_RM_SESSION_KEY + 1] = {};
+		if (RmStartSession(&Session, 0, SessionKey) != ERROR_SUCCESS)
+		{
+			return;
+		}
+
+		TArray<FString> FullPaths;
+		TArray<LPCWSTR> Resources;
+		for (const FString& FilePath : FilePaths)
+		{
+			FullPaths.Add(FPaths::ConvertRelativePathToFull(FilePath));
+		}
+		for (const FString& FullPath : FullPaths)
+		{
+			Resources.Add(*FullPath);
+		}
+
+		if (RmRegisterResources(Session, Resources.Num(), Resources.GetData(), 0, nullptr, 0, nullptr) == ERROR_SUCCESS)
+		{
+			// The holder count can change between the calls, so retry while the buffer is too small
+			TArray<RM_PROCESS_INFO> Processes;
+			UINT Needed = 0;
+			UINT Count = 0;
+			DWORD RebootReasons = 0;
+			DWORD Result;
+			do
+			{
+				Processes.SetNum(Needed);
+				Count = Needed;
+				Result = RmGetList(Session, &Needed, &Count, Processes.GetData(), &RebootReasons);
+			}
+			while (Result == ERROR_MORE_DATA);
+
+			if (Result == ERROR_SUCCESS)
+			{
+				for (UINT Index = 0; Index < Count; Index++)
+				{
+					FModDeployLockHolder& Holder = OutHolders.AddDefaulted_GetRef();
+					Holder.ProcessId = Processes[Index].Process.dwProcessId;
+					// The full image path, ProcessesToKill and the status text use the executable name
+					Holder.Name = FPaths::GetCleanFilename(FPlatformProcess::GetApplicationName(Holder.ProcessId));
+					if (Holder.Name.IsEmpty())
+					{
+						Holder.Name = Processes[Index].strAppName;
+					}
+				}
+			}
+		}
+
+		RmEndSession(Session);
+#endif
+	}
+
+	// Move all existing targets aside and the new files in. Either every file is swapped or none is
+	bool TrySwap(const TArray<FModBuildOutputFile>& Files)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+		// Renaming fails for files opened without delete sharing, which is exactly the lock we have to wait for
+		TArray<const FModBuildOutputFile*> MovedAside;
+		for (const FModBuildOutputFile& File : Files)
+		{
+			if (!PlatformFile.FileExists(*File.DestPath))
+			{
+				continue;
+			}
+
+			if (!PlatformFile.MoveFile(*(File.DestPath + TEXT(".old")), *File.DestPath))
+			{
+				for (const FModBuildOutputFile* Restore : MovedAside)
+				{
+					PlatformFile.MoveFile(*Restore->DestPath, *(Restore->DestPath + TEXT(".old")));
+				}
+				return false;
+			}
+
+			MovedAside.Add(&File);
+		}
+
+		// Scanners briefly lock freshly written files, a failed move puts everything back and the caller retries
+		TArray<const FModBuildOutputFile*> MovedIn;
+		for (const FModBuildOutputFile& File : Files)
+		{
+			if (PlatformFile.MoveFile(*File.DestPath, *(File.DestPath + TEXT(".tmp"))))
+			{
+				MovedIn.Add(&File);
+				continue;
+			}
+
+			UE_LOG(LogModdingEx, Warning, TEXT("Failed to move '%s.tmp' into place, restoring the previous files"), *File.DestPath);
+			for (const FModBuildOutputFile* Restore : MovedIn)
+			{
+				if (!PlatformFile.MoveFile(*(Restore->DestPath + TEXT(".tmp")), *Restore->DestPath))
+				{
+					UE_LOG(LogModdingEx, Error, TEXT("Failed to move '%s' back to '%s.tmp'"), *Restore->DestPath, *Restore->DestPath);
+				}
+			}
+			for (const FModBuildOutputFile* Restore : MovedAside)
+			{
+				if (!PlatformFile.MoveFile(*Restore->DestPath, *(Restore->DestPath + TEXT(".old"))))
+				{
+					UE_LOG(LogModdingEx, Error, TEXT("Failed to restore '%s' from '%s.old'"), *Restore->DestPath, *Restore->DestPath);
+				}
+			}
+			return false;
+		}
+
+		for (const FModBuildOutputFile* Old : MovedAside)
+		{
+			PlatformFile.DeleteFile(*(Old->DestPath + TEXT(".old")));
+		}
+
+		return true;
+	}
+
+	bool DeployFilesAtomic(const TArray<FModBuildOutputFile>& Files, const FModDeployOptions& Options, FString& OutError)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+		auto DeleteTempFiles = [&PlatformFile, &Files]
+		{
+			for (const FModBuildOutputFile& File : Files)
+			{
+				PlatformFile.DeleteFile(*(File.DestPath + TEXT(".tmp")));
+			}
+		};
+
+		// --- Write next to the targets, so the swap is a rename on the same volume ---
+		for (const FModBuildOutputFile& File : Files)
+		{
+			// Leftovers of an interrupted deploy
+			PlatformFile.DeleteFile(*(File.DestPath + TEXT(".old")));
+
+			EModDeployMethod Method;
+			if (!DeployFile(File.SourcePath, File.DestPath + TEXT(".tmp"), Options.bKeepSources, Method))
+			{
+				DeleteTempFiles();
+				OutError = FString::Format(TEXT("Failed to write '{0}.tmp'. Check logs."), {File.DestPath});
+				return false;
+			}
+
+			UE_LOG(LogModdingEx, Log, TEXT("Deployed '%s' to '%s.tmp' (%s)"), *File.SourcePath, *File.DestPath, LexToString(Method));
+		}
+
+		// --- Swap once nothing holds the old files open ---
+		TArray<FString> DestPaths;
+		for (const FModBuildOutputFile& File : Files)
+		{
+			DestPaths.Add(File.DestPath);
+		}
+
+		double Deadline = FPlatformTime::Seconds() + Options.LockTimeoutSeconds;
+		bool bKilled = false;
+		TArray<FModDeployLockHolder> Holders;
+
+		while (!TrySwap(Files))
+		{
+			if (Options.ShouldCancel && Options.ShouldCancel())
+			{
+				DeleteTempFiles();
+				OutError = TEXT("Build was cancelled");
+				return false;
+			}
+
+			FindLockHolders(DestPaths, Holders);
+
+			TArray<FString> HolderNames;
+			for (const FModDeployLockHolder& Holder : Holders)
+			{
+				HolderNames.AddUnique(Holder.Name);
+			}
+			const FString HolderList = HolderNames.IsEmpty() ? TEXT("an unknown process") : FString::Join(HolderNames, TEXT(", "));
+
+			if (FPlatformTime::Seconds() < Deadline)
+			{
+				if (Options.OnStatus)
+				{
+					Options.OnStatus(FString::Printf(TEXT("Waiting for %s to release the mod files"), *HolderList));
+				}
+				FPlatformProcess::Sleep(0.25f);
+				continue;
+			}
+
+			// Last resort, only processes the user listed are ever killed
+			if (!bKilled && !Options.ProcessesToKill.IsEmpty())
+			{
+				bKilled = true;
+				for (const FModDeployLockHolder& Holder : Holders)
+				{
+					if (!Options.ProcessesToKill.ContainsByPredicate([&Holder](const FString& Name) { return Name.Equals(FPaths::GetCleanFilename(Holder.Name), ESearchCase::IgnoreCase); }))
+					{
+						continue;
+					}
+
+					FProcHandle ProcHandle = FPlatformProcess::OpenProcess(Holder.ProcessId);
+					if (ProcHandle.IsValid())
+					{
+						UE_LOG(LogModdingEx, Log, TEXT("Killing %s (%u) so the pak files can be replaced"), *Holder.Name, Holder.ProcessId);
+						FPlatformProcess::TerminateProc(ProcHandle);
+						FPlatformProcess::CloseProc(ProcHandle);
+					}
+				}
+
+				// Give the killed processes a moment to release their handles
+				Deadline = FPlatformTime::Seconds() + 2.0;
+				continue;
+			}
+
+			DeleteTempFiles();
+			OutError = FString::Format(TEXT("The mod files are still opened by {0}. Close it and build again, the previously deployed files were left untouched."), {HolderList});
+			return false;
+		}
+
+		return true;
+	}
+
+	bool DeployFile(const FString& SourcePath, const FString& DestPath, bool bKeepSource, EModDeployMethod& OutMethod)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+		PlatformFile.CreateDirectoryTree(*FPaths::GetPath(DestPath));
+		if (PlatformFile.FileExists(*DestPath) && !PlatformFile.DeleteFile(*DestPath))
+		{
+			UE_LOG(LogModdingEx, Warning, TEXT("Could not remove '%s' before deploying, it is probably still open"), *DestPath);
+		}
+
+		// Renames and reflinks only work within a volume and fail right away otherwise.
+		// A kept source is never hardlinked, the cache entry and the deployed file would be one file and a write to either changes both
+		if (!bKeepSource && PlatformFile.MoveFile(*DestPath, *SourcePath))
+		{
+			OutMethod = EModDeployMethod::Rename;
+			return true;
+		}
+
+		if (TryReflink(SourcePath, DestPath))
+		{
+			OutMethod = EModDeployMethod::Reflink;
+			return true;
+		}
+
+		OutMethod = EModDeployMethod::Copy;
+		return CopyFileChunked(SourcePath, DestPath);
+	}
+}
@@ -0,0 +1,55 @@
+﻿#include "Build/ModHash.h"
+
+#include "HAL/PlatformFileManager.h"
+
+namespace ModHash
+{
+	constexpr int64 HashChunkSize = 1024 * 1024;
+
+	bool HashFile(const FString& FilePath, FSHAHash& OutHash)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		const TUniquePtr<IFileHandle> FileHandle(PlatformFile.OpenRead(*FilePath));
+		if (!FileHandle)
+		{
+			return false;
+		}
+
+		TArray<uint8> Buffer;
+		Buffer.SetNumUninitialized(HashChunkSize);
+
+		FSHA1 Sha;
+		int64 Remaining = FileHandle->Size();
+		while (Remaining > 0)
+		{
+			const int64 ChunkSize = FMath::Min(Remaining, HashChunkSize);
+			if (!FileHandle->Read(Buffer.GetData(), ChunkSize))
+			{
+				return false;
+			}
+
+			Sha.Update(Buffer.GetData(), ChunkSize);
+			Remaining -= ChunkSize;
+		}
+
+		Sha.Final();
+		Sha.GetHash(OutHash.Hash);
+		return true;
+	}
+
+	bool AreFilesEqual(const FString& FilePathA, const FString& FilePathB)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+		const int64 SizeA = PlatformFile.FileSize(*FilePathA);
+		const int64 SizeB = PlatformFile.FileSize(*FilePathB);
+		if (SizeA < 0 || SizeB < 0 || SizeA != SizeB)
+		{
+			return false;
+		}
+
+		FSHAHash HashA;
+		FSHAHash HashB;
+		return HashFile(FilePathA, HashA) && HashFile(FilePathB, HashB) && HashA == HashB;
+	}
+}
@@ -0,0 +1,160 @@
+#include "Build/ModMembershipSubsystem.h"
+
+#include "FileHelpers.h"
+#include "ModdingEx.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "UObject/ObjectSaveContext.h"
+
+void UModMembershipSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddWeakLambda(this, [this](const FAssetData&) { Invalidate(); });
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddWeakLambda(this, [this](const FAssetData&) { Invalidate(); });
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddUObject(this, &UModMembershipSubsystem::OnAssetRenamed);
+
+	// References only reach the Asset Registry once a package is saved
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddUObject(this, &UModMembershipSubsystem::OnPackageSaved);
+}
+
+void UModMembershipSubsystem::Deinitialize()
+{
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+	}
+
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+
+	Super::Deinitialize();
+}
+
+void UModMembershipSubsystem::Invalidate()
+{
+	ModPackages.Empty();
+	ModPackageSets.Empty();
+}
+
+void UModMembershipSubsystem::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	Invalidate();
+}
+
+void UModMembershipSubsystem::OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext ObjectSaveContext)
+{
+	Invalidate();
+}
+
+const TSet<FName>* UModMembershipSubsystem::ResolveMod(const FString& ModName)
+{
+	if (const TSet<FName>* PackageSet = ModPackageSets.Find(ModName))
+	{
+		return PackageSet;
+	}
+
+	FModCookSet CookSet;
+	if (!ModCookSet::Collect(ModName, CookSet))
+	{
+		return nullptr;
+	}
+
+	const TSet<FName>& PackageSet = ModPackageSets.Add(ModName, TSet<FName>(CookSet.Packages));
+	ModPackages.Add(ModName, MoveTemp(CookSet));
+	return &PackageSet;
+}
+
+bool UModMembershipSubsystem::GetModPackages(const FString& ModName, FModCookSet& OutCookSet)
+{
+	if (!ResolveMod(ModName))
+	{
+		return false;
+	}
+
+	const FModCookSet& CookSet = ModPackages[ModName];
+	for (const FName& PackageName : CookSet.Packages)
+	{
+		OutCookSet.Packages.AddUnique(PackageName);
+	}
+	for (const FName& PackageName : CookSet.ExternalPackages)
+	{
+		OutCookSet.ExternalPackages.AddUnique(PackageName);
+	}
+	return true;
+}
+
+bool UModMembershipSubsystem::IsPackageInMod(FName PackageName, const FString& ModName)
+{
+	const TSet<FName>* PackageSet = ResolveMod(ModName);
+	return PackageSet && PackageSet->Contains(PackageName);
+}
+
+bool UModMembershipSubsystem::GetDirtyPackages(const TArray<FString>& ModNames, TArray<UPackage*>& OutModPackages, TArray<UPackage*>& OutUnrelatedPackages)
+{
+	TArray<UPackage*> DirtyPackages;
+	FEditorFileUtils::GetDirtyContentPackages(DirtyPackages);
+	FEditorFileUtils::GetDirtyWorldPackages(DirtyPackages);
+
+	for (const FString& ModName : ModNames)
+	{
+		if (!ResolveMod(ModName))
+		{
+			return false;
+		}
+	}
+
+	// Resolving adds to the map, so only take pointers into it once every mod is resolved
+	TArray<const TSet<FName>*, TInlineAllocator<4>> PackageSets;
+	for (const FString& ModName : ModNames)
+	{
+		PackageSets.Add(&ModPackageSets[ModName]);
+	}
+
+	for (UPackage* Package : DirtyPackages)
+	{
+		const FName PackageName = Package->GetFName();
+		const bool bInMod = PackageSets.ContainsByPredicate([PackageName](const TSet<FName>* PackageSet) { return PackageSet->Contains(PackageName); });
+		(bInMod ? OutModPackages : OutUnrelatedPackages).AddUnique(Package);
+	}
+
+	return true;
+}
+
+EModPackageSaveResult UModMembershipSubsystem::SaveDirtyModPackages(const TArray<FString>& ModNames, TArray<FString>& OutUnrelatedPackages)
+{
+	// The Asset Registry only sees the references of saved packages, so saving can pull further dirty packages into the mods.
+	// Saving invalidates the sets, so resolve again until a pass finds nothing new to save
+	TSet<UPackage*> SavedPackages;
+	TArray<UPackage*> UnrelatedPackages;
+	for (;;)
+	{
+		TArray<UPackage*> ModDirtyPackages;
+		UnrelatedPackages.Reset();
+		if (!GetDirtyPackages(ModNames, ModDirtyPackages, UnrelatedPackages))
+		{
+			return EModPackageSaveResult::NotResolved;
+		}
+
+		ModDirtyPackages.RemoveAll([&SavedPackages](UPackage* Package) { return SavedPackages.Contains(Package); });
+		if (ModDirtyPackages.IsEmpty())
+		{
+			break;
+		}
+
+		UE_LOG(LogModdingEx, Log, TEXT("Saving %d dirty packages of %s, leaving %d unrelated ones unsaved"), ModDirtyPackages.Num(), *FString::Join(ModNames, TEXT(", ")), UnrelatedPackages.Num());
+		if (FEditorFileUtils::PromptForCheckoutAndSave(ModDirtyPackages, true, false) != FEditorFileUtils::PR_Success)
+		{
+			return EModPackageSaveResult::Failed;
+		}
+		SavedPackages.Append(ModDirtyPackages);
+	}
+
+	for (const UPackage* Package : UnrelatedPackages)
+	{
+		OutUnrelatedPackages.Add(Package->GetName());
+	}
+	return EModPackageSaveResult::Saved;
+}
@@ -0,0 +1,172 @@
+#include "Build/ModPackager.h"
+
+#include "ModdingEx.h"
+#include "Build/ModBuildContext.h"
+#include "Build/ModBuildProcess.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace ModPackager
+{
+	// The cooker names the Windows platform differently than UAT
+	FString GetCookedPlatformName(const FString& PlatformName)
+	{
+		return PlatformName == TEXT("Win64") ? TEXT("Windows") : PlatformName;
+	}
+
+	FString GetExecutableName(const FString& BaseName)
+	{
+#if PLATFORM_WINDOWS
+		return BaseName + TEXT(".exe");
+#else
+		return BaseName;
+#endif
+	}
+
+	// Packages go into the IoStore container, everything else stays in the pak
+	bool IsPackageFile(const FString& FilePath)
+	{
+		const FString Extension = FPaths::GetExtension(FilePath);
+		return Extension == TEXT("uasset") || Extension == TEXT("umap") || Extension == TEXT("uexp") ||
+			Extension == TEXT("ubulk") || Extension == TEXT("uptnl");
+	}
+
+	FString GetCookedModDir(const FModBuildContext& Context)
+	{
+		return Context.CookOutputDir / GetCookedPlatformName(Context.PlatformName) / FApp::GetProjectName() / TEXT("Content/Mods") / Context.ModName;
+	}
+
+	bool HasCookedOutput(const FModBuildContext& Context)
+	{
+		// Only the mod dir is packed here, assets referenced from elsewhere need the pak UAT writes.
+		// The cooked files must come from the last build, an older cook may still be around in a staging root used before
+		return Context.bPersistentStaging && !Context.IsBatch() && Context.bCookSetResolved && Context.CookSet.ExternalPackages.IsEmpty() &&
+			Context.bHasPreviousManifest && !Context.PreviousManifest.CookOutputDir.IsEmpty() &&
+			FPaths::IsSamePath(Context.PreviousManifest.CookOutputDir, FPaths::ConvertRelativePathToFull(Context.CookOutputDir)) &&
+			FPaths::DirectoryExists(GetCookedModDir(Context));
+	}
+
+	bool RunTool(FModBuildContext& Context, const FString& Executable, const FString& Params, const TFunction<void(const FString& Line)>& OnOutput)
+	{
+		UE_LOG(LogModdingEx, Log, TEXT("Command: %s %s"), *Executable, *Params);
+
+		FModBuildProcess Process(Executable, Params);
+		Process.OnOutput = OnOutput;
+		Process.ShouldCancel = [&Context] { return Context.bCancelRequested.load(); };
+
+		int32 ReturnCode = -1;
+		if (!Process.Run(ReturnCode) || ReturnCode != 0)
+		{
+			if (Process.WasCancelled())
+			{
+				Context.ErrorMessage = TEXT("Build was cancelled");
+				return false;
+			}
+
+			UE_LOG(LogModdingEx, Error, TEXT("Execution failed for '%s'. Return Code: %d"), *FPaths::GetCleanFilename(Executable), ReturnCode);
+			Context.ErrorMessage = FString::Format(TEXT("Step '{0}' failed (Code: {1}). Check logs for details."), {FPaths::GetCleanFilename(Executable), ReturnCode});
+			return false;
+		}
+
+		return true;
+	}
+
+	bool Package(FModBuildContext& Context, const TFunction<void(const FString& Line)>& OnOutput)
+	{
+		IFileManager& FileManager = IFileManager::Get();
+		const FModBuildSettingsSnapshot& Settings = Context.BuildSettings;
+
+		const FString CookedModDir = FPaths::ConvertRelativePathToFull(GetCookedModDir(Context));
+		const FString CookedPlatformDir = FPaths::ConvertRelativePathToFull(Context.CookOutputDir / GetCookedPlatformName(Context.PlatformName));
+		const FString MountPoint = FString(TEXT("../../../")) / FApp::GetProjectName() / TEXT("Content/Mods") / Context.ModName;
+		const FString PaksDir = FPaths::ConvertRelativePathToFull(Context.TempStagingDir / TEXT("Paks"));
+		const FString CompressFlag = Settings.bCompressed ? TEXT(" -compress") : TEXT("");
+
+		TArray<FString> CookedFiles;
+		FileManager.FindFilesRecursive(CookedFiles, *CookedModDir, TEXT("*"), true, false);
+		if (CookedFiles.IsEmpty())
+		{
+			Context.ErrorMessage = FString::Format(TEXT("No cooked files found for mod '{0}' in: {1}"), {Context.ModName, CookedModDir});
+			return false;
+		}
+
+		// Response files list "<cooked file>" "<path in the pak>" per line, the same format UAT writes
+		TArray<FString> PakLines;
+		TArray<FString> ContainerLines;
+		for (const FString& CookedFile : CookedFiles)
+		{
+			FString RelativePath = CookedFile;
+			FPaths::MakePathRelativeTo(RelativePath, *(CookedModDir + TEXT("/")));
+
+			const FString Line = FString::Printf(TEXT("\"%s\" \"%s\"%s"), *CookedFile, *(MountPoint / RelativePath), *CompressFlag);
+			(Context.bUseIoStore && IsPackageFile(CookedFile) ? ContainerLines : PakLines).Add(Line);
+		}
+
+		FileManager.MakeDirectory(*PaksDir, true);
+
+		const FString PakResponseFile = PaksDir / TEXT("PakList.txt");
+		if (!FFileHelper::SaveStringArrayToFile(PakLines, *PakResponseFile))
+		{
+			Context.ErrorMessage = FString::Format(TEXT("Failed to write response file: {0}"), {PakResponseFile});
+			return false;
+		}
+
+		FString CompressionParams;
+		if (Settings.bCompressed)
+		{
+			CompressionParams = FString::Printf(TEXT(" -compressionformats=%s %s"), *Settings.CompressionFormats, *Settings.CompressionOptions);
+		}
+
+		const FString BinariesDir = FPaths::ConvertRelativePathToFull(FPaths::EngineDir() / TEXT("Binaries") / FPlatformProcess::GetBinariesSubdirectory());
+		const FString PlatformParam = FString::Printf(TEXT(" -platform=%s"), *GetCookedPlatformName(Context.PlatformName));
+
+		// --- Pak ---
+		const FString PakFile = PaksDir / (Context.ModName + TEXT(".pak"));
+		Context.Profiler.BeginPhase(EModBuildPhase::Pak);
+		const FString PakParams = FString::Printf(TEXT("\"%s\" -create=\"%s\"%s%s -utf8output"), *PakFile, *PakResponseFile, *PlatformParam, *CompressionParams);
+		if (!RunTool(Context, BinariesDir / GetExecutableName(TEXT("UnrealPak")), PakParams, OnOutput))
+		{
+			return false;
+		}
+
+		Context.OutputFiles.Empty();
+		Context.OutputFiles.Add({ PakFile, Context.FinalDestinationDir / (Context.ModName + TEXT(".pak")) });
+
+		if (!Context.bUseIoStore)
+		{
+			Context.Profiler.EndPhase();
+			return true;
+		}
+
+		// --- IoStore container ---
+		const FString ContainerResponseFile = PaksDir / TEXT("IoStoreList.txt");
+		const FString CommandsFile = PaksDir / TEXT("IoStoreCommands.txt");
+		const FString ContainerFile = PaksDir / (Context.ModName + TEXT(".utoc"));
+		const FString Command = FString::Printf(TEXT("-Output=\"%s\" -ContainerName=%s -ResponseFile=\"%s\""), *ContainerFile, *Context.ModName, *ContainerResponseFile);
+
+		if (!FFileHelper::SaveStringArrayToFile(ContainerLines, *ContainerResponseFile) || !FFileHelper::SaveStringToFile(Command, *CommandsFile))
+		{
+			Context.ErrorMessage = FString::Format(TEXT("Failed to write response file: {0}"), {ContainerResponseFile});
+			return false;
+		}
+
+		const FString MetadataDir = CookedPlatformDir / FApp::GetProjectName() / TEXT("Metadata");
+		const FString ProjectPath = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+		const FString IoStoreParams = FString::Printf(
+			TEXT("\"%s\" -run=iostore -CookedDirectory=\"%s\" -PackageStoreManifest=\"%s\" -ScriptObjects=\"%s\" -Commands=\"%s\"%s%s -unattended -utf8output"),
+			*ProjectPath, *CookedPlatformDir, *(MetadataDir / TEXT("packagestore.manifest")), *(MetadataDir / TEXT("scriptobjects.bin")),
+			*CommandsFile, *PlatformParam, *CompressionParams);
+
+		Context.Profiler.BeginPhase(EModBuildPhase::IoStore);
+		if (!RunTool(Context, BinariesDir / GetExecutableName(TEXT("UnrealEditor-Cmd")), IoStoreParams, OnOutput))
+		{
+			return false;
+		}
+
+		Context.OutputFiles.Add({ ContainerFile, Context.FinalDestinationDir / (Context.ModName + TEXT(".utoc")) });
+		Context.OutputFiles.Add({ PaksDir / (Context.ModName + TEXT(".ucas")), Context.FinalDestinationDir / (Context.ModName + TEXT(".ucas")) });
+		Context.Profiler.EndPhase();
+		return true;
+	}
+}
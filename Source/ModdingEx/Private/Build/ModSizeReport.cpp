@@ -0,0 +1,252 @@
+#include "Build/ModSizeReport.h"
+
+#include "IPlatformFilePak.h"
+#include "JsonObjectConverter.h"
+#include "ModdingEx.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "HAL/PlatformFileManager.h"
+#include "IO/IoStore.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace ModSizeReport
+{
+	FString GetReportPath(const FString& ModName)
+	{
+		return FPaths::ProjectSavedDir() / TEXT("ModdingEx") / TEXT("SizeReports") / (ModName + TEXT(".json"));
+	}
+
+	bool Load(const FString& ModName, FModSizeReport& OutReport)
+	{
+		FString JsonString;
+		if (!FFileHelper::LoadFileToString(JsonString, *GetReportPath(ModName)))
+		{
+			return false;
+		}
+
+		return FJsonObjectConverter::JsonObjectStringToUStruct(JsonString, &OutReport, 0, 0);
+	}
+
+	bool Save(const FString& ModName, const FModSizeReport& Report)
+	{
+		FString JsonString;
+		if (!FJsonObjectConverter::UStructToJsonObjectString(Report, JsonString))
+		{
+			return false;
+		}
+
+		if (!FFileHelper::SaveStringToFile(JsonString, *GetReportPath(ModName)))
+		{
+			UE_LOG(LogModdingEx, Warning, TEXT("Failed to save size report: %s"), *GetReportPath(ModName));
+			return false;
+		}
+
+		return true;
+	}
+
+	FString FormatSize(int64 Bytes)
+	{
+		return FString::Printf(TEXT("%.2f MB"), Bytes / (1024.0 * 1024.0));
+	}
+
+	// Turn a path in a container ("../../../<Project>/Content/Mods/X/Foo.uexp") into its package name ("/Game/Mods/X/Foo")
+	FString GetPackageName(const FString& ContainerPath)
+	{
+		const FString Extension = FPaths::GetExtension(ContainerPath);
+		const bool bIsPackageFile = Extension == TEXT("uasset") || Extension == TEXT("umap") || Extension == TEXT("uexp") ||
+			Extension == TEXT("ubulk") || Extension == TEXT("uptnl");
+		if (!bIsPackageFile)
+		{
+			return ContainerPath;
+		}
+
+		FString Path = ContainerPath;
+		Path.RemoveFromStart(TEXT("../../../"));
+
+		const FString ProjectContent = FString(FApp::GetProjectName()) / TEXT("Content/");
+		if (Path.RemoveFromStart(ProjectContent))
+		{
+			Path = TEXT("/Game/") + Path;
+		}
+		else if (Path.RemoveFromStart(TEXT("Engine/Content/")))
+		{
+			Path = TEXT("/Engine/") + Path;
+		}
+		else
+		{
+			return ContainerPath;
+		}
+
+		// Everything after the first dot of the file name, so "Foo.m.ubulk" belongs to "Foo" as well
+		int32 SlashIndex = 0;
+		Path.FindLastChar(TEXT('/'), SlashIndex);
+		const int32 DotIndex = Path.Find(TEXT("."), ESearchCase::CaseSensitive, ESearchDir::FromStart, SlashIndex);
+		return DotIndex != INDEX_NONE ? Path.Left(DotIndex) : Path;
+	}
+
+	void AddFile(TMap<FString, FModSizeReportPackage>& Packages, const FString& ContainerPath, int64 CompressedSize, int64 UncompressedSize)
+	{
+		const FString PackageName = GetPackageName(ContainerPath);
+		FModSizeReportPackage& Package = Packages.FindOrAdd(PackageName);
+		Package.PackageName = PackageName;
+		Package.CompressedSize += CompressedSize;
+		Package.UncompressedSize += UncompressedSize;
+	}
+
+	bool ReadPak(const FString& PakPath, TMap<FString, FModSizeReportPackage>& Packages)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		const TRefCountPtr<FPakFile> PakFile = new FPakFile(&PlatformFile, *PakPath, false);
+		if (!PakFile->IsValid())
+		{
+			UE_LOG(LogModdingEx, Warning, TEXT("Failed to read the index of %s"), *PakPath);
+			return false;
+		}
+
+		const FString& MountPoint = PakFile->GetMountPoint();
+		for (FPakFile::FFilenameIterator It(*PakFile); It; ++It)
+		{
+			const FPakEntry& Entry = It.Info();
+			AddFile(Packages, MountPoint / It.Filename(), Entry.CompressionMethodIndex != 0 ? Entry.CompressedSize : Entry.Size, Entry.Size);
+		}
+
+		return true;
+	}
+
+	bool ReadIoStore(const FString& ContainerPath, TMap<FString, FModSizeReportPackage>& Packages)
+	{
+		FIoStoreReader Reader;
+		if (!Reader.Initialize(*ContainerPath, TMap<FGuid, FAES::FAESKey>()).IsOk())
+		{
+			UE_LOG(LogModdingEx, Warning, TEXT("Failed to read the TOC of %s.utoc"), *ContainerPath);
+			return false;
+		}
+
+		Reader.EnumerateChunks([&Packages](const FIoStoreTocChunkInfo& ChunkInfo)
+		{
+			const FString ChunkName = ChunkInfo.bHasValidFileName ? ChunkInfo.FileName : BytesToHex(ChunkInfo.Id.GetData(), ChunkInfo.Id.GetSize());
+			AddFile(Packages, ChunkName, ChunkInfo.CompressedSize, ChunkInfo.Size);
+			return true;
+		});
+
+		return true;
+	}
+
+	void AddToGroup(TMap<FString, FModSizeReportGroup>& Groups, const FString& Name, const FModSizeReportPackage& Package)
+	{
+		FModSizeReportGroup& Group = Groups.FindOrAdd(Name);
+		Group.Name = Name;
+		Group.Packages++;
+		Group.CompressedSize += Package.CompressedSize;
+		Group.UncompressedSize += Package.UncompressedSize;
+	}
+
+	template <typename T>
+	void SortBySize(TArray<T>& Items)
+	{
+		Items.Sort([](const T& A, const T& B) { return A.CompressedSize > B.CompressedSize; });
+	}
+
+	bool Generate(const FString& ModName, const FString& PakPath, FModSizeReport& OutReport)
+	{
+		TMap<FString, FModSizeReportPackage> Packages;
+		if (!ReadPak(PakPath, Packages))
+		{
+			return false;
+		}
+
+		const FString ContainerPath = FPaths::ChangeExtension(PakPath, TEXT(""));
+		if (FPaths::FileExists(ContainerPath + TEXT(".utoc")))
+		{
+			ReadIoStore(ContainerPath, Packages);
+		}
+
+		const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+		OutReport = FModSizeReport();
+		OutReport.ModName = ModName;
+		OutReport.Time = FDateTime::Now().ToString();
+
+		TMap<FString, FModSizeReportGroup> Directories;
+		TMap<FString, FModSizeReportGroup> Classes;
+		TArray<FAssetData> Assets;
+		for (TPair<FString, FModSizeReportPackage>& Pair : Packages)
+		{
+			FModSizeReportPackage& Package = Pair.Value;
+
+			Assets.Reset();
+			if (Package.PackageName.StartsWith(TEXT("/")))
+			{
+				AssetRegistry.GetAssetsByPackageName(*Package.PackageName, Assets, true);
+			}
+			Package.AssetClass = Assets.IsEmpty() ? TEXT("Other") : Assets[0].AssetClassPath.GetAssetName().ToString();
+
+			AddToGroup(Directories, FPaths::GetPath(Package.PackageName), Package);
+			AddToGroup(Classes, Package.AssetClass, Package);
+
+			OutReport.CompressedSize += Package.CompressedSize;
+			OutReport.UncompressedSize += Package.UncompressedSize;
+			OutReport.Packages.Add(MoveTemp(Package));
+		}
+
+		Directories.GenerateValueArray(OutReport.Directories);
+		Classes.GenerateValueArray(OutReport.Classes);
+		SortBySize(OutReport.Packages);
+		SortBySize(OutReport.Directories);
+		SortBySize(OutReport.Classes);
+		return true;
+	}
+
+	void LogTopContributors(const FModSizeReport& Report, int32 Count)
+	{
+		UE_LOG(LogModdingEx, Log, TEXT("Size of '%s': %s compressed, %s uncompressed, %d packages"), *Report.ModName,
+			*FormatSize(Report.CompressedSize), *FormatSize(Report.UncompressedSize), Report.Packages.Num());
+
+		auto LogItems = [Count](const TCHAR* Title, const auto& Items, auto GetName)
+		{
+			UE_LOG(LogModdingEx, Log, TEXT("  Largest %s:"), Title);
+			for (int32 Index = 0; Index < FMath::Min(Count, Items.Num()); Index++)
+			{
+				UE_LOG(LogModdingEx, Log, TEXT("    %10s %10s  %s"), *FormatSize(Items[Index].CompressedSize), *FormatSize(Items[Index].UncompressedSize), *GetName(Items[Index]));
+			}
+		};
+
+		LogItems(TEXT("packages"), Report.Packages, [](const FModSizeReportPackage& Package) { return Package.PackageName + TEXT(" (") + Package.AssetClass + TEXT(")"); });
+		LogItems(TEXT("directories"), Report.Directories, [](const FModSizeReportGroup& Group) { return Group.Name; });
+		LogItems(TEXT("classes"), Report.Classes, [](const FModSizeReportGroup& Group) { return Group.Name; });
+	}
+
+	FString DescribeGrowth(const FModSizeReport& Previous, const FModSizeReport& Current, float ThresholdPercent, int32 Count)
+	{
+		const int64 Growth = Current.CompressedSize - Previous.CompressedSize;
+		if (Growth <= 0 || Growth * 100.0 < Previous.CompressedSize * (double)ThresholdPercent)
+		{
+			return FString();
+		}
+
+		TMap<FString, int64> PreviousSizes;
+		for (const FModSizeReportPackage& Package : Previous.Packages)
+		{
+			PreviousSizes.Add(Package.PackageName, Package.CompressedSize);
+		}
+
+		TArray<TPair<FString, int64>> Growths;
+		for (const FModSizeReportPackage& Package : Current.Packages)
+		{
+			const int64 PackageGrowth = Package.CompressedSize - PreviousSizes.FindRef(Package.PackageName);
+			if (PackageGrowth > 0)
+			{
+				Growths.Emplace(Package.PackageName, PackageGrowth);
+			}
+		}
+		Growths.Sort([](const TPair<FString, int64>& A, const TPair<FString, int64>& B) { return A.Value > B.Value; });
+
+		FString Description = FString::Printf(TEXT("Pak grew by %s to %s (%+.0f%%)"), *FormatSize(Growth), *FormatSize(Current.CompressedSize),
+			Previous.CompressedSize > 0 ? Growth * 100.0 / Previous.CompressedSize : 100.0);
+		for (int32 Index = 0; Index < FMath::Min(Count, Growths.Num()); Index++)
+		{
+			Description += FString::Printf(TEXT("\n  +%s %s"), *FormatSize(Growths[Index].Value), *FPaths::GetBaseFilename(Growths[Index].Key));
+		}
+		return Description;
+	}
+}
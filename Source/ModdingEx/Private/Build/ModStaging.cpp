@@ -0,0 +1,153 @@
+#include "Build/ModStaging.h"
+
+#include "ModdingEx.h"
+#include "ModdingExSettings.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace ModStaging
+{
+	// Cooked packages, their staged copies and the pak built from them
+	constexpr int64 ContentSizeMultiplier = 3;
+
+	// Where the Auto location picked for persistent staging is remembered
+	FString GetPinnedRootPath()
+	{
+		return FPaths::ProjectIntermediateDir() / TEXT("ModdingEx") / TEXT("PersistentStagingRoot.txt");
+	}
+
+	int64 EstimateRequiredBytes(const TArray<FString>& ModNames, const TArray<FString>& ExternalPackageFiles)
+	{
+		IFileManager& FileManager = IFileManager::Get();
+
+		int64 ContentBytes = 0;
+		for (const FString& ModName : ModNames)
+		{
+			FileManager.IterateDirectoryStatRecursively(*(FPaths::ProjectContentDir() / TEXT("Mods") / ModName),
+				[&ContentBytes](const TCHAR*, const FFileStatData& StatData)
+				{
+					ContentBytes += StatData.bIsDirectory ? 0 : StatData.FileSize;
+					return true;
+				});
+		}
+
+		for (const FString& PackageFile : ExternalPackageFiles)
+		{
+			ContentBytes += FMath::Max<int64>(0, FileManager.FileSize(*PackageFile));
+		}
+
+		return ContentBytes * ContentSizeMultiplier + (int64)GetDefault<UModdingExSettings>()->MinFreeStagingSpaceMB * 1024 * 1024;
+	}
+
+	FString FindRamDisk()
+	{
+		const FString& RamDiskDir = GetDefault<UModdingExSettings>()->RamDiskDir.Path;
+		if (!RamDiskDir.IsEmpty())
+		{
+			return FPaths::DirectoryExists(RamDiskDir) ? RamDiskDir : FString();
+		}
+
+#if PLATFORM_LINUX
+		// tmpfs on every common distribution, backed by memory and swap
+		if (FPaths::DirectoryExists(TEXT("/dev/shm")))
+		{
+			return TEXT("/dev/shm");
+		}
+#endif
+
+		return FString();
+	}
+
+	// The RAM disk if it and the physical memory have room for the build and a cooker next to it, Intermediate otherwise
+	FString ResolveAutoRoot(const FString& RamDisk, int64 RequiredBytes, bool& bOutIsRamDisk)
+	{
+		if (!RamDisk.IsEmpty())
+		{
+			// The cooker itself needs its memory too, files on the RAM disk only fit next to it
+			const int64 CookerBytes = (int64)GetDefault<UModdingExSettings>()->CookerMemoryMB * 1024 * 1024;
+			const int64 AvailableBytes = (int64)FPlatformMemory::GetStats().AvailablePhysical;
+
+			uint64 TotalBytes = 0;
+			uint64 FreeBytes = 0;
+			const bool bHasDiskSpace = FPlatformMisc::GetDiskTotalAndFreeSpace(RamDisk, TotalBytes, FreeBytes) && (int64)FreeBytes >= RequiredBytes;
+
+			if (bHasDiskSpace && AvailableBytes >= RequiredBytes + CookerBytes)
+			{
+				bOutIsRamDisk = true;
+				return FPaths::ConvertRelativePathToFull(RamDisk / TEXT("ModdingEx") / FApp::GetProjectName());
+			}
+
+			UE_LOG(LogModdingEx, Log, TEXT("Not enough memory for staging on %s (%lld MB needed, %lld MB free), using Intermediate"), *RamDisk,
+				(RequiredBytes + CookerBytes) / (1024 * 1024), AvailableBytes / (1024 * 1024));
+		}
+
+		return FPaths::ConvertRelativePathToFull(FPaths::ProjectIntermediateDir());
+	}
+
+	FString ResolveRoot(int64 RequiredBytes, bool bPersistent, bool& bOutIsRamDisk)
+	{
+		const UModdingExSettings* Settings = GetDefault<UModdingExSettings>();
+		bOutIsRamDisk = false;
+
+		if (Settings->StagingLocation == EModStagingLocation::Custom && !Settings->CustomStagingDir.Path.IsEmpty())
+		{
+			return FPaths::ConvertRelativePathToFull(Settings->CustomStagingDir.Path);
+		}
+
+		if (Settings->StagingLocation == EModStagingLocation::Auto)
+		{
+			const FString RamDisk = FindRamDisk();
+
+			// The memory check is skipped for a pinned RAM disk, the kept cook already takes up its share.
+			// A RAM disk that was cleared or filled up by something else loses the pin, the cook starts over wherever there's room then
+			FString PinnedRoot;
+			if (bPersistent && FFileHelper::LoadFileToString(PinnedRoot, *GetPinnedRootPath()) && FPaths::DirectoryExists(PinnedRoot / TEXT("ModdingExCooked")))
+			{
+				uint64 TotalBytes = 0;
+				uint64 FreeBytes = 0;
+				if (!FPlatformMisc::GetDiskTotalAndFreeSpace(PinnedRoot, TotalBytes, FreeBytes) || (int64)FreeBytes >= RequiredBytes)
+				{
+					bOutIsRamDisk = !RamDisk.IsEmpty() && PinnedRoot.StartsWith(FPaths::ConvertRelativePathToFull(RamDisk));
+					return PinnedRoot;
+				}
+
+				UE_LOG(LogModdingEx, Log, TEXT("Not enough space left for persistent staging in %s, the mods are cooked from scratch elsewhere"), *PinnedRoot);
+			}
+
+			const FString Root = ResolveAutoRoot(RamDisk, RequiredBytes, bOutIsRamDisk);
+			if (bPersistent)
+			{
+				FFileHelper::SaveStringToFile(Root, *GetPinnedRootPath());
+			}
+			return Root;
+		}
+
+		return FPaths::ConvertRelativePathToFull(FPaths::ProjectIntermediateDir());
+	}
+
+	bool HasFreeSpace(const FString& Dir, int64 RequiredBytes, FString& OutError)
+	{
+		// Windows only reports the free space of existing dirs
+		IFileManager::Get().MakeDirectory(*Dir, true);
+
+		uint64 TotalBytes = 0;
+		uint64 FreeBytes = 0;
+		if (!FPlatformMisc::GetDiskTotalAndFreeSpace(Dir, TotalBytes, FreeBytes))
+		{
+			UE_LOG(LogModdingEx, Warning, TEXT("Could not get the free space of %s, building anyway"), *Dir);
+			return true;
+		}
+
+		if ((int64)FreeBytes < RequiredBytes)
+		{
+			OutError = FString::Printf(TEXT("Not enough free space to stage the build in %s: %lld MB needed, %lld MB free."), *Dir,
+				RequiredBytes / (1024 * 1024), (int64)(FreeBytes / (1024 * 1024)));
+			return false;
+		}
+
+		return true;
+	}
+}
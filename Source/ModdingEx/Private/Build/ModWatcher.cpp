@@ -0,0 +1,159 @@
+#include "Build/ModWatcher.h"
+
+#include "DirectoryWatcherModule.h"
+#include "ModBuilder.h"
+#include "ModdingEx.h"
+#include "ModdingExSettings.h"
+#include "Build/ModMembershipSubsystem.h"
+#include "Editor.h"
+#include "Misc/PackageName.h"
+#include "UObject/ObjectSaveContext.h"
+
+FModWatcher::~FModWatcher()
+{
+	Shutdown();
+}
+
+bool FModWatcher::IsWatching(const FString& ModName) const
+{
+	return WatchedMods.Contains(ModName);
+}
+
+FString FModWatcher::GetWatchedDir(const FString& ModName) const
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir() / TEXT("Mods") / ModName);
+}
+
+void FModWatcher::SetWatching(const FString& ModName, bool bWatch)
+{
+	if (bWatch == IsWatching(ModName))
+	{
+		return;
+	}
+
+	IDirectoryWatcher* DirectoryWatcher = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>("DirectoryWatcher").Get();
+
+	if (!bWatch)
+	{
+		if (DirectoryWatcher)
+		{
+			DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(GetWatchedDir(ModName), WatchedMods[ModName].DirectoryHandle);
+		}
+		WatchedMods.Remove(ModName);
+
+		if (WatchedMods.IsEmpty())
+		{
+			UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+			FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		}
+
+		UE_LOG(LogModdingEx, Log, TEXT("Stopped watching '%s'"), *ModName);
+		return;
+	}
+
+	FWatchedMod& WatchedMod = WatchedMods.Add(ModName);
+	if (DirectoryWatcher)
+	{
+		DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(GetWatchedDir(ModName),
+			IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FModWatcher::OnDirectoryChanged, ModName), WatchedMod.DirectoryHandle);
+	}
+
+	if (WatchedMods.Num() == 1)
+	{
+		PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FModWatcher::OnPackageSaved);
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FModWatcher::Tick), 0.1f);
+	}
+
+	UE_LOG(LogModdingEx, Log, TEXT("Watching '%s', saved changes are built and deployed in the background"), *ModName);
+}
+
+void FModWatcher::Shutdown()
+{
+	TArray<FString> ModNames;
+	WatchedMods.GetKeys(ModNames);
+	for (const FString& ModName : ModNames)
+	{
+		SetWatching(ModName, false);
+	}
+}
+
+void FModWatcher::OnChange(const FString& ModName)
+{
+	FWatchedMod& WatchedMod = WatchedMods[ModName];
+	WatchedMod.LastChangeTime = FPlatformTime::Seconds();
+	WatchedMod.bChangePending = true;
+
+	// The running build is already stale, the next one starts once the changes settle
+	if (UModBuilder::IsModBuilding(ModName))
+	{
+		UModBuilder::CancelBuild(ModName);
+	}
+}
+
+void FModWatcher::OnDirectoryChanged(const TArray<FFileChangeData>& Changes, FString ModName)
+{
+	if (!WatchedMods.Contains(ModName))
+	{
+		return;
+	}
+
+	for (const FFileChangeData& Change : Changes)
+	{
+		// Packages saved by the editor were already seen through the save event, only changes from outside count here
+		FString PackageName;
+		if (FPackageName::TryConvertFilenameToLongPackageName(Change.Filename, PackageName) && FindPackage(nullptr, *PackageName))
+		{
+			continue;
+		}
+
+		UE_LOG(LogModdingEx, Verbose, TEXT("'%s' changed on disk: %s"), *ModName, *Change.Filename);
+		OnChange(ModName);
+		return;
+	}
+}
+
+void FModWatcher::OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext ObjectSaveContext)
+{
+	if (bStartingBuild || ObjectSaveContext.IsProceduralSave() || !GEditor)
+	{
+		return;
+	}
+
+	UModMembershipSubsystem* Membership = GEditor->GetEditorSubsystem<UModMembershipSubsystem>();
+	const FName PackageName = Package->GetFName();
+
+	TArray<FString> ModNames;
+	WatchedMods.GetKeys(ModNames);
+	for (const FString& ModName : ModNames)
+	{
+		// Referenced assets outside the mod folder change the mod as well
+		const bool bInModDir = PackageName.ToString().StartsWith(TEXT("/Game/Mods/") + ModName + TEXT("/"));
+		if (bInModDir || (Membership && Membership->IsPackageInMod(PackageName, ModName)))
+		{
+			OnChange(ModName);
+		}
+	}
+}
+
+bool FModWatcher::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	const float DebounceSeconds = GetDefault<UModdingExSettings>()->WatchDebounceSeconds;
+
+	for (TPair<FString, FWatchedMod>& Pair : WatchedMods)
+	{
+		FWatchedMod& WatchedMod = Pair.Value;
+		if (!WatchedMod.bChangePending || Now - WatchedMod.LastChangeTime < DebounceSeconds || UModBuilder::IsModBuilding(Pair.Key))
+		{
+			continue;
+		}
+
+		WatchedMod.bChangePending = false;
+
+		UE_LOG(LogModdingEx, Log, TEXT("'%s' changed, rebuilding"), *Pair.Key);
+		TGuardValue<bool> StartingBuildGuard(bStartingBuild, true);
+		UModBuilder::BuildModAsync(Pair.Key);
+	}
+
+	return true;
+}
@@ -0,0 +1,308 @@
+#include "Build/SModBuildHistory.h"
+
+#include "Rendering/DrawElements.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/STextComboBox.h"
+#include "Widgets/Layout/SWrapBox.h"
+#include "Widgets/Text/STextBlock.h"
+
+#define LOCTEXT_NAMESPACE "ModBuildHistory"
+
+void SModBuildHistoryGraph::Construct(const FArguments& InArgs)
+{
+	OnHoveredChanged = InArgs._OnHoveredChanged;
+}
+
+void SModBuildHistoryGraph::SetRecords(const TArray<FModBuildRecord>& InRecords)
+{
+	Records = InRecords;
+	HoveredIndex = INDEX_NONE;
+}
+
+FLinearColor SModBuildHistoryGraph::GetPhaseColor(EModBuildPhase Phase)
+{
+	static const FLinearColor Colors[] = {
+		FLinearColor(0.55f, 0.55f, 0.55f), // SavePackages
+		FLinearColor(0.35f, 0.35f, 0.45f), // Uat
+		FLinearColor(0.85f, 0.35f, 0.25f), // Compile
+		FLinearColor(0.20f, 0.55f, 0.90f), // Cook
+		FLinearColor(0.30f, 0.75f, 0.45f), // Stage
+		FLinearColor(0.95f, 0.75f, 0.20f), // Pak
+		FLinearColor(0.75f, 0.45f, 0.85f), // IoStore
+		FLinearColor(0.50f, 0.80f, 0.80f), // Package
+		FLinearColor(0.95f, 0.50f, 0.65f), // Copy
+		FLinearColor(0.60f, 0.45f, 0.30f), // Zip
+	};
+	static_assert(UE_ARRAY_COUNT(Colors) == (int32)EModBuildPhase::Num, "Every phase needs a color");
+
+	return Colors[(int32)Phase];
+}
+
+int32 SModBuildHistoryGraph::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+	FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	const FSlateBrush* WhiteBrush = FAppStyle::GetBrush("WhiteBrush");
+	const FVector2D Size = AllottedGeometry.GetLocalSize();
+
+	FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(), WhiteBrush, ESlateDrawEffect::None, FLinearColor(0.02f, 0.02f, 0.02f));
+
+	if (Records.IsEmpty())
+	{
+		return LayerId;
+	}
+
+	double MaxSeconds = 1.0;
+	for (const FModBuildRecord& Record : Records)
+	{
+		MaxSeconds = FMath::Max(MaxSeconds, Record.TotalSeconds);
+	}
+
+	const float BarSlot = Size.X / Records.Num();
+	const float BarWidth = FMath::Max(1.0f, BarSlot * 0.8f);
+
+	for (int32 Index = 0; Index < Records.Num(); Index++)
+	{
+		const FModBuildRecord& Record = Records[Index];
+		const float X = Index * BarSlot + (BarSlot - BarWidth) * 0.5f;
+
+		// Time not covered by any phase (hash checks, cleanup) is drawn as the dark top of the bar
+		const float TotalHeight = Size.Y * Record.TotalSeconds / MaxSeconds;
+		FSlateDrawElement::MakeBox(OutDrawElements, LayerId + 1, AllottedGeometry.ToPaintGeometry(FVector2D(BarWidth, TotalHeight), FSlateLayoutTransform(FVector2D(X, Size.Y - TotalHeight))),
+			WhiteBrush, ESlateDrawEffect::None, Index == HoveredIndex ? FLinearColor(0.4f, 0.4f, 0.4f) : FLinearColor(0.15f, 0.15f, 0.15f));
+
+		float Y = Size.Y;
+		for (int32 Phase = 0; Phase < (int32)EModBuildPhase::Num; Phase++)
+		{
+			const float Height = Size.Y * Record.PhaseSeconds[Phase] / MaxSeconds;
+			if (Height <= 0.0f)
+			{
+				continue;
+			}
+
+			Y -= Height;
+			FLinearColor Color = GetPhaseColor((EModBuildPhase)Phase);
+			if (Index == HoveredIndex)
+			{
+				Color = Color * 1.3f;
+			}
+
+			FSlateDrawElement::MakeBox(OutDrawElements, LayerId + 2, AllottedGeometry.ToPaintGeometry(FVector2D(BarWidth, Height), FSlateLayoutTransform(FVector2D(X, Y))),
+				WhiteBrush, ESlateDrawEffect::None, Color);
+		}
+	}
+
+	return LayerId + 2;
+}
+
+FReply SModBuildHistoryGraph::OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	const int32 NewHoveredIndex = GetRecordAt(MyGeometry, MouseEvent.GetScreenSpacePosition());
+	if (NewHoveredIndex != HoveredIndex)
+	{
+		HoveredIndex = NewHoveredIndex;
+		OnHoveredChanged.ExecuteIfBound(HoveredIndex);
+	}
+	return FReply::Handled();
+}
+
+void SModBuildHistoryGraph::OnMouseLeave(const FPointerEvent& MouseEvent)
+{
+	SLeafWidget::OnMouseLeave(MouseEvent);
+
+	HoveredIndex = INDEX_NONE;
+	OnHoveredChanged.ExecuteIfBound(HoveredIndex);
+}
+
+FVector2D SModBuildHistoryGraph::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	return FVector2D(400.0f, 200.0f);
+}
+
+int32 SModBuildHistoryGraph::GetRecordAt(const FGeometry& Geometry, const FVector2D& ScreenPosition) const
+{
+	if (Records.IsEmpty())
+	{
+		return INDEX_NONE;
+	}
+
+	const FVector2D LocalPosition = Geometry.AbsoluteToLocal(ScreenPosition);
+	const int32 Index = FMath::FloorToInt(LocalPosition.X / (Geometry.GetLocalSize().X / Records.Num()));
+	return Records.IsValidIndex(Index) ? Index : INDEX_NONE;
+}
+
+void SModBuildHistory::Construct(const FArguments& InArgs)
+{
+	TSharedRef<SWrapBox> Legend = SNew(SWrapBox).UseAllottedSize(true);
+	for (int32 Phase = 0; Phase < (int32)EModBuildPhase::Num; Phase++)
+	{
+		Legend->AddSlot()
+		.Padding(0, 0, 12, 0)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(LexToString((EModBuildPhase)Phase)))
+			.ColorAndOpacity(SModBuildHistoryGraph::GetPhaseColor((EModBuildPhase)Phase))
+		];
+	}
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(8)
+		[
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			.Padding(0, 0, 8, 0)
+			[
+				SNew(STextBlock)
+				.Text(LOCTEXT("Mod", "Mod"))
+			]
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.0f)
+			[
+				SAssignNew(ModComboBox, STextComboBox)
+				.OptionsSource(&ModNames)
+				.OnSelectionChanged_Lambda([this](TSharedPtr<FString> Selected, ESelectInfo::Type)
+				{
+					if (Selected.IsValid())
+					{
+						SelectMod(*Selected);
+					}
+				})
+			]
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(8, 0, 0, 0)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("Reload", "Reload"))
+				.OnClicked_Lambda([this]
+				{
+					Reload();
+					return FReply::Handled();
+				})
+			]
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(8, 0)
+		[
+			Legend
+		]
+		+ SVerticalBox::Slot()
+		.FillHeight(1.0f)
+		.Padding(8)
+		[
+			SAssignNew(Graph, SModBuildHistoryGraph)
+			.OnHoveredChanged(this, &SModBuildHistory::OnHoveredChanged)
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(8)
+		[
+			SAssignNew(Details, STextBlock)
+			.AutoWrapText(true)
+		]
+	];
+
+	Reload();
+}
+
+void SModBuildHistory::Reload()
+{
+	ModBuildHistory::Load(AllRecords);
+
+	const FString SelectedMod = ModComboBox.IsValid() && ModComboBox->GetSelectedItem().IsValid() ? *ModComboBox->GetSelectedItem() : FString();
+
+	ModNames.Empty();
+	TSet<FString> KnownMods;
+	for (const FModBuildRecord& Record : AllRecords)
+	{
+		if (!KnownMods.Contains(Record.ModName))
+		{
+			KnownMods.Add(Record.ModName);
+			ModNames.Add(MakeShared<FString>(Record.ModName));
+		}
+	}
+
+	ModComboBox->RefreshOptions();
+
+	// Keep the selection across reloads, otherwise show the most recently built mod
+	const FString ModToSelect = KnownMods.Contains(SelectedMod) ? SelectedMod : (AllRecords.IsEmpty() ? FString() : AllRecords.Last().ModName);
+	for (const TSharedPtr<FString>& ModName : ModNames)
+	{
+		if (*ModName == ModToSelect)
+		{
+			ModComboBox->SetSelectedItem(ModName);
+		}
+	}
+
+	SelectMod(ModToSelect);
+}
+
+void SModBuildHistory::SelectMod(const FString& ModName)
+{
+	ModRecords = AllRecords.FilterByPredicate([&ModName](const FModBuildRecord& Record) { return Record.ModName == ModName; });
+	Graph->SetRecords(ModRecords);
+	OnHoveredChanged(ModRecords.Num() - 1);
+}
+
+void SModBuildHistory::OnHoveredChanged(int32 Index)
+{
+	Details->SetText(DescribeRecord(Index == INDEX_NONE ? ModRecords.Num() - 1 : Index));
+}
+
+FText SModBuildHistory::DescribeRecord(int32 Index) const
+{
+	if (!ModRecords.IsValidIndex(Index))
+	{
+		return LOCTEXT("NoBuilds", "No builds recorded yet.");
+	}
+
+	const FModBuildRecord& Record = ModRecords[Index];
+
+	FString Description = FString::Printf(TEXT("%s - %s - %.1fs"), *Record.Time.ToString(), *Record.Result, Record.TotalSeconds);
+	for (int32 Phase = 0; Phase < (int32)EModBuildPhase::Num; Phase++)
+	{
+		if (Record.PhaseSeconds[Phase] > 0.0)
+		{
+			Description += FString::Printf(TEXT("\n  %s: %.1fs (peak %.0f MB)"), LexToString((EModBuildPhase)Phase), Record.PhaseSeconds[Phase], Record.PhasePeakMemoryMB[Phase]);
+		}
+	}
+
+	// Point out what changed since the build before, so a regression can be attributed. Zips have nothing to compare
+	const bool bIsZip = Record.Result.StartsWith(TEXT("Zip"));
+	int32 PreviousIndex = Index - 1;
+	while (ModRecords.IsValidIndex(PreviousIndex) && ModRecords[PreviousIndex].Result.StartsWith(TEXT("Zip")))
+	{
+		PreviousIndex--;
+	}
+
+	if (!bIsZip && ModRecords.IsValidIndex(PreviousIndex))
+	{
+		const FModBuildRecord& Previous = ModRecords[PreviousIndex];
+
+		TArray<FString> Changes;
+		if (Record.InputFiles != Previous.InputFiles || Record.InputBytes != Previous.InputBytes)
+		{
+			Changes.Add(FString::Printf(TEXT("content (%+d files, %+.2f MB)"), Record.InputFiles - Previous.InputFiles, (Record.InputBytes - Previous.InputBytes) / (1024.0 * 1024.0)));
+		}
+		if (Record.SettingsHash != Previous.SettingsHash)
+		{
+			Changes.Add(TEXT("packaging settings"));
+		}
+		if (Record.EngineVersion != Previous.EngineVersion)
+		{
+			Changes.Add(FString::Printf(TEXT("engine (%s -> %s)"), *Previous.EngineVersion, *Record.EngineVersion));
+		}
+
+		Description += FString::Printf(TEXT("\nChanged since the previous build: %s"), Changes.IsEmpty() ? TEXT("nothing") : *FString::Join(Changes, TEXT(", ")));
+	}
+
+	return FText::FromString(Description);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Build/ModBuildProfiler.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/SLeafWidget.h"
+
+/** Stacked bar per build with one segment per phase, the bar under the cursor is reported through OnHoveredChanged */
+class SModBuildHistoryGraph : public SLeafWidget
+{
+public:
+	DECLARE_DELEGATE_OneParam(FOnHoveredChanged, int32);
+
+	SLATE_BEGIN_ARGS(SModBuildHistoryGraph) {}
+		SLATE_EVENT(FOnHoveredChanged, OnHoveredChanged)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	void SetRecords(const TArray<FModBuildRecord>& InRecords);
+
+	static FLinearColor GetPhaseColor(EModBuildPhase Phase);
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements,
+		int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual FReply OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual void OnMouseLeave(const FPointerEvent& MouseEvent) override;
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+	int32 GetRecordAt(const FGeometry& Geometry, const FVector2D& ScreenPosition) const;
+
+	TArray<FModBuildRecord> Records;
+	int32 HoveredIndex = INDEX_NONE;
+	FOnHoveredChanged OnHoveredChanged;
+};
+
+/** Editor tab showing the build history of a mod, to tell if a slower build came from content, settings or the engine */
+class SModBuildHistory : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SModBuildHistory) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+private:
+	void Reload();
+	void SelectMod(const FString& ModName);
+	void OnHoveredChanged(int32 Index);
+	FText DescribeRecord(int32 Index) const;
+
+	TArray<FModBuildRecord> AllRecords;
+	TArray<FModBuildRecord> ModRecords;
+
+	TArray<TSharedPtr<FString>> ModNames;
+	TSharedPtr<class STextComboBox> ModComboBox;
+	TSharedPtr<SModBuildHistoryGraph> Graph;
+	TSharedPtr<class STextBlock> Details;
+};
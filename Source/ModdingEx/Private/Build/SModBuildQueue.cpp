@@ -0,0 +1,227 @@
+#include "Build/SModBuildQueue.h"
+
+#include "ModdingAssets.h"
+#include "Build/ModBuildContext.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Views/STableRow.h"
+
+#define LOCTEXT_NAMESPACE "ModBuildQueue"
+
+namespace ModBuildQueueColumns
+{
+	const FName Mod = TEXT("Mod");
+	const FName State = TEXT("State");
+	const FName Time = TEXT("Time");
+	const FName Progress = TEXT("Progress");
+	const FName Cancel = TEXT("Cancel");
+}
+
+/** One queued mod, the texts are bound so running builds update without rebuilding the list */
+class SModBuildQueueRow : public SMultiColumnTableRow<TSharedRef<FModBuildQueueItem>>
+{
+public:
+	SLATE_BEGIN_ARGS(SModBuildQueueRow) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable, const TSharedRef<FModBuildQueueItem>& InItem)
+	{
+		Item = InItem;
+		SMultiColumnTableRow::Construct(FSuperRowType::FArguments(), OwnerTable);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		if (ColumnName == ModBuildQueueColumns::Mod)
+		{
+			return SNew(STextBlock).Text(FText::FromString(Item->ModName));
+		}
+
+		if (ColumnName == ModBuildQueueColumns::State)
+		{
+			return SNew(STextBlock)
+				.Text_Lambda([this] { return FText::FromString(LexToString(Item->State)); })
+				.ColorAndOpacity_Lambda([this] { return GetStateColor(); });
+		}
+
+		if (ColumnName == ModBuildQueueColumns::Time)
+		{
+			return SNew(STextBlock).Text_Lambda([this]
+			{
+				if (Item->State == EModBuildQueueState::Queued || Item->StartTime <= 0.0)
+				{
+					return FText::GetEmpty();
+				}
+				const double EndTime = Item->State == EModBuildQueueState::Building ? FPlatformTime::Seconds() : Item->EndTime;
+				return FText::FromString(FString::Printf(TEXT("%.0fs"), EndTime - Item->StartTime));
+			});
+		}
+
+		if (ColumnName == ModBuildQueueColumns::Progress)
+		{
+			return SNew(STextBlock).Text_Lambda([this]
+			{
+				if (!Item->Context.IsValid())
+				{
+					return FText::GetEmpty();
+				}
+				if (Item->IsFinished())
+				{
+					return FText::FromString(Item->Context->ErrorMessage);
+				}
+
+				const float Fraction = Item->Context->Progress.GetFraction(Item->Context->Profiler);
+				const FString Status = Item->Context->Progress.GetStatus(Item->Context->Profiler);
+				return FText::FromString(Fraction >= 0.0f ? FString::Printf(TEXT("%d%% - %s"), FMath::FloorToInt(Fraction * 100.0f), *Status) : Status);
+			});
+		}
+
+		if (ColumnName == ModBuildQueueColumns::Cancel)
+		{
+			return SNew(SButton)
+				.Text(LOCTEXT("Cancel", "Cancel"))
+				.IsEnabled_Lambda([this] { return !Item->IsFinished(); })
+				.OnClicked_Lambda([this]
+				{
+					FModBuildScheduler::Get().Cancel(Item->ModName);
+					return FReply::Handled();
+				});
+		}
+
+		return SNullWidget::NullWidget;
+	}
+
+private:
+	FSlateColor GetStateColor() const
+	{
+		switch (Item->State)
+		{
+		case EModBuildQueueState::Building: return FLinearColor(0.20f, 0.55f, 0.90f);
+		case EModBuildQueueState::Built: return FLinearColor(0.30f, 0.75f, 0.45f);
+		case EModBuildQueueState::Failed: return FLinearColor(0.85f, 0.35f, 0.25f);
+		case EModBuildQueueState::Cancelled: return FLinearColor(0.95f, 0.75f, 0.20f);
+		default: return FSlateColor::UseForeground();
+		}
+	}
+
+	TSharedPtr<FModBuildQueueItem> Item;
+};
+
+void SModBuildQueue::Construct(const FArguments& InArgs)
+{
+	FModBuildScheduler& Scheduler = FModBuildScheduler::Get();
+	OnChangedHandle = Scheduler.OnChanged.AddSP(this, &SModBuildQueue::Refresh);
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(8)
+		[
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.0f)
+			.VAlign(VAlign_Center)
+			[
+				SNew(STextBlock)
+				.Text(this, &SModBuildQueue::GetSummaryText)
+			]
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(8, 0, 0, 0)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("BuildAll", "Build All Mods"))
+				.ToolTipText(LOCTEXT("BuildAllTooltip", "Queue every mod, each one is cooked in its own UAT run"))
+				.OnClicked_Lambda([]
+				{
+					TArray<FString> Mods;
+					ModdingAssets::GetMods(Mods);
+					FModBuildScheduler::Get().Enqueue(Mods);
+					return FReply::Handled();
+				})
+			]
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(8, 0, 0, 0)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("CancelAll", "Cancel All"))
+				.IsEnabled_Lambda([] { return !FModBuildScheduler::Get().IsIdle(); })
+				.OnClicked_Lambda([]
+				{
+					FModBuildScheduler::Get().CancelAll();
+					return FReply::Handled();
+				})
+			]
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(8, 0, 0, 0)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("ClearFinished", "Clear Finished"))
+				.OnClicked_Lambda([]
+				{
+					FModBuildScheduler::Get().ClearFinished();
+					return FReply::Handled();
+				})
+			]
+		]
+		+ SVerticalBox::Slot()
+		.FillHeight(1.0f)
+		.Padding(8, 0, 8, 8)
+		[
+			SAssignNew(ListView, SListView<TSharedRef<FModBuildQueueItem>>)
+			.ListItemsSource(&Items)
+			.SelectionMode(ESelectionMode::None)
+			.OnGenerateRow(this, &SModBuildQueue::OnGenerateRow)
+			.HeaderRow
+			(
+				SNew(SHeaderRow)
+				+ SHeaderRow::Column(ModBuildQueueColumns::Mod).DefaultLabel(LOCTEXT("ModColumn", "Mod")).FillWidth(0.2f)
+				+ SHeaderRow::Column(ModBuildQueueColumns::State).DefaultLabel(LOCTEXT("StateColumn", "State")).FillWidth(0.1f)
+				+ SHeaderRow::Column(ModBuildQueueColumns::Time).DefaultLabel(LOCTEXT("TimeColumn", "Time")).FillWidth(0.08f)
+				+ SHeaderRow::Column(ModBuildQueueColumns::Progress).DefaultLabel(LOCTEXT("ProgressColumn", "Progress")).FillWidth(0.52f)
+				+ SHeaderRow::Column(ModBuildQueueColumns::Cancel).DefaultLabel(FText::GetEmpty()).FillWidth(0.1f)
+			)
+		]
+	];
+
+	Refresh();
+}
+
+SModBuildQueue::~SModBuildQueue()
+{
+	FModBuildScheduler::Get().OnChanged.Remove(OnChangedHandle);
+}
+
+void SModBuildQueue::Refresh()
+{
+	Items = FModBuildScheduler::Get().GetItems();
+	ListView->RequestListRefresh();
+}
+
+TSharedRef<ITableRow> SModBuildQueue::OnGenerateRow(TSharedRef<FModBuildQueueItem> Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SModBuildQueueRow, OwnerTable, Item);
+}
+
+FText SModBuildQueue::GetSummaryText() const
+{
+	const FModBuildScheduler& Scheduler = FModBuildScheduler::Get();
+
+	int32 NumBuilding = 0;
+	int32 NumQueued = 0;
+	for (const TSharedRef<FModBuildQueueItem>& Item : Scheduler.GetItems())
+	{
+		NumBuilding += Item->State == EModBuildQueueState::Building;
+		NumQueued += Item->State == EModBuildQueueState::Queued;
+	}
+
+	return FText::FromString(FString::Printf(TEXT("%d building, %d queued, up to %d at once (%d cores, %lld MB free)"), NumBuilding, NumQueued,
+		Scheduler.GetMaxConcurrency(), FPlatformMisc::NumberOfCoresIncludingHyperthreads(), FModBuildScheduler::GetAvailableMemoryMB()));
+}
+
+#undef LOCTEXT_NAMESPACE
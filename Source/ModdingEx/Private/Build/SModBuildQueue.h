@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Build/ModBuildScheduler.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+/** Editor tab listing the mods in the build queue with their state and progress */
+class SModBuildQueue : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SModBuildQueue) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+	virtual ~SModBuildQueue() override;
+
+private:
+	void Refresh();
+	TSharedRef<ITableRow> OnGenerateRow(TSharedRef<FModBuildQueueItem> Item, const TSharedRef<STableViewBase>& OwnerTable);
+	FText GetSummaryText() const;
+
+	TArray<TSharedRef<FModBuildQueueItem>> Items;
+	TSharedPtr<SListView<TSharedRef<FModBuildQueueItem>>> ListView;
+	FDelegateHandle OnChangedHandle;
+};
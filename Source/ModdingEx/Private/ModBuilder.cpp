@@ -4,9 +4,26 @@
 #include "ISettingsModule.h"
 #include "ModdingEx.h"
 #include "ModdingExSettings.h"
+#include "Notifications.h"
 #include "Async/Async.h"
-#include "FileUtilities/ZipArchiveWriter.h"
+#include "Containers/Ticker.h"
+#include "Build/ModBuildCache.h"
+#include "Build/ModBuildContext.h"
+#include "Build/ModHash.h"
+#include "Build/ModBuildNotification.h"
+#include "Build/ModBuildProcess.h"
+#include "Build/ModChunks.h"
+#include "Build/ModCookSet.h"
+#include "Build/ModDeploy.h"
+#include "Build/ModMembershipSubsystem.h"
+#include "Build/ModPackager.h"
+#include "Build/ModSizeReport.h"
+#include "Build/ModStaging.h"
+#include "Zip/ModZipState.h"
+#include "Zip/ModZipWriter.h"
+#include "Zip/ZipFile.h"
 #include "Framework/Notifications/NotificationManager.h"
+#include "Interfaces/IPluginManager.h"
 #include "Misc/FileHelper.h"
 #include "Misc/ScopedSlowTask.h"
 #include "Widgets/Notifications/SNotificationList.h"
@@ -19,49 +36,128 @@
 #include "HAL/PlatformFileManager.h"
 #include "HAL/FileManager.h"
 #include "Misc/Paths.h"
+#include "Misc/PackageName.h"
 #include "Misc/Guid.h"
+#include "Misc/EngineVersion.h"
 #include "Editor.h"
 #include "Internationalization/Regex.h"
 
-// Helper function to execute a process and log output
-// Returns true on success (ReturnCode 0), false otherwise.
-bool ExecProcessAndLog(const FString& Command, const FString& Params, const FText& StepDescription)
+// Mods with a build in flight and the context of that build, only touched on the game thread
+static TMap<FString, FModBuildContext*> ActiveModBuilds;
+
+// Forward a line of UAT output to the log with a matching verbosity, errors and warnings are kept for the build report
+void LogUatLine(FModBuildContext& Context, const FString& Line)
 {
-	int32 ReturnCode = -1;
-	FString StdOut;
-	FString StdErr;
+	if (Line.Contains(TEXT("error:"), ESearchCase::IgnoreCase))
+	{
+		UE_LOG(LogModdingEx, Error, TEXT("[UAT] %s"), *Line);
+		Context.Warnings.Add(Line);
+	}
+	else if (Line.Contains(TEXT("warning:"), ESearchCase::IgnoreCase))
+	{
+		UE_LOG(LogModdingEx, Warning, TEXT("[UAT] %s"), *Line);
+		Context.Warnings.Add(Line);
+	}
+	else
+	{
+		UE_LOG(LogModdingEx, Log, TEXT("[UAT] %s"), *Line);
+	}
+}
+
+// Show a build error as a modal dialog, background builds report it through their notification instead and commandlets only log it
+void ShowBuildError(FModBuildContext& Context, const FString& Message)
+{
+	UE_LOG(LogModdingEx, Error, TEXT("%s"), *Message);
+
+	if (IsRunningCommandlet())
+	{
+		return;
+	}
 
-	UE_LOG(LogModdingEx, Log, TEXT("Executing Step: %s"), *StepDescription.ToString());
-	UE_LOG(LogModdingEx, Log, TEXT("Command: %s %s"), *Command, *Params);
+	if (Context.Notification.IsValid())
+	{
+		Context.Notification->Complete(false, FText::FromString(Message));
+		Context.Notification.Reset();
+		return;
+	}
 
-	bool bSuccess = FPlatformProcess::ExecProcess(*Command, *Params, &ReturnCode, &StdOut, &StdErr);
+	FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Message));
+}
 
-	// Log output regardless of success for debugging
-	if (!StdOut.IsEmpty())
+// Delete the staging dir of a build, persistent staging dirs are kept for the next iterative cook
+void CleanupStaging(const FModBuildContext& Context)
+{
+	if (Context.bPersistentStaging)
 	{
-		UE_LOG(LogModdingEx, Log, TEXT("StdOut:\n%s"), *StdOut);
+		return;
 	}
-	if (!StdErr.IsEmpty())
+
+	UE_LOG(LogModdingEx, Log, TEXT("Cleaning up temporary staging directory: %s"), *Context.TempStagingDir);
+	if (!IFileManager::Get().DeleteDirectory(*Context.TempStagingDir, false, true))
 	{
-		// Log standard error as warnings or errors based on return code
-		if (ReturnCode != 0) {
-			UE_LOG(LogModdingEx, Error, TEXT("StdErr:\n%s"), *StdErr);
-		} else {
-			UE_LOG(LogModdingEx, Warning, TEXT("StdErr (Warnings):\n%s"), *StdErr);
+		UE_LOG(LogModdingEx, Warning, TEXT("Could not delete temporary staging directory: %s"), *Context.TempStagingDir);
+	}
+}
+
+// Newest modification time of the source files in a dir, FDateTime::MinValue if there are none
+FDateTime GetNewestSourceTimestamp(const FString& Directory)
+{
+	FDateTime Newest = FDateTime::MinValue();
+	IFileManager::Get().IterateDirectoryStatRecursively(*Directory, [&Newest](const TCHAR* FilenameOrDirectory, const FFileStatData& StatData)
+	{
+		const FString Extension = FPaths::GetExtension(FilenameOrDirectory);
+		if (!StatData.bIsDirectory && (Extension == TEXT("cpp") || Extension == TEXT("h") || Extension == TEXT("cs") || Extension == TEXT("inl")))
+		{
+			Newest = FMath::Max(Newest, StatData.ModificationTime);
 		}
+		return true;
+	});
+	return Newest;
+}
+
+// Whether the shipping game target was never built or any project or plugin source is newer than its receipt
+bool IsCodeBuildNeeded(const FString& PlatformName)
+{
+	const bool bHasCode = FPaths::DirectoryExists(FPaths::GameSourceDir());
+
+	// Content-only projects stage the engine's prebuilt UnrealGame
+	const FString ReceiptPath = bHasCode
+		? FPaths::ProjectDir() / TEXT("Binaries") / PlatformName / FString::Printf(TEXT("%s-%s-Shipping.target"), FApp::GetProjectName(), *PlatformName)
+		: FPaths::EngineDir() / TEXT("Binaries") / PlatformName / FString::Printf(TEXT("UnrealGame-%s-Shipping.target"), *PlatformName);
+
+	const FFileStatData ReceiptStat = IFileManager::Get().GetStatData(*ReceiptPath);
+	if (!ReceiptStat.bIsValid)
+	{
+		UE_LOG(LogModdingEx, Log, TEXT("No build receipt found at '%s', building the game target"), *ReceiptPath);
+		return true;
 	}
 
-	if (!bSuccess || ReturnCode != 0)
+	if (!bHasCode)
 	{
-		UE_LOG(LogModdingEx, Error, TEXT("Execution failed for '%s'. Return Code: %d"), *StepDescription.ToString(), ReturnCode);
-		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(FString::Format(TEXT("Step '{0}' failed (Code: {1}). Check logs for details."), {StepDescription.ToString(), ReturnCode})));
 		return false;
 	}
 
-	UE_LOG(LogModdingEx, Log, TEXT("Execution successful for '%s'."), *StepDescription.ToString());
-	return true;
-}
+	FDateTime NewestSource = FMath::Max(GetNewestSourceTimestamp(FPaths::GameSourceDir()), IFileManager::Get().GetTimeStamp(*FPaths::GetProjectFilePath()));
 
+	// The plugin manager knows plugins nested in subfolders of Plugins and those in additional plugin dirs, disabled ones included
+	for (const TSharedRef<IPlugin>& Plugin : IPluginManager::Get().GetDiscoveredPlugins())
+	{
+		if (Plugin->GetLoadedFrom() == EPluginLoadedFrom::Project)
+		{
+			NewestSource = FMath::Max(NewestSource, IFileManager::Get().GetTimeStamp(*Plugin->GetDescriptorFileName()));
+			NewestSource = FMath::Max(NewestSource, GetNewestSourceTimestamp(Plugin->GetBaseDir() / TEXT("Source")));
+		}
+	}
+
+	if (NewestSource > ReceiptStat.ModificationTime)
+	{
+		UE_LOG(LogModdingEx, Log, TEXT("Source files changed since the game target was last built, building it"));
+		return true;
+	}
+
+	UE_LOG(LogModdingEx, Log, TEXT("Game target is up to date, skipping the code build"));
+	return false;
+}
 
 // Toggle live coding for building
 void SetLiveCoding(bool coding)
@@ -72,30 +168,56 @@ void SetLiveCoding(bool coding)
         coding,
         GEditorPerProjectIni
     );
-    
+
     GConfig->Flush(false, GEditorPerProjectIni);
 }
 
-bool UModBuilder::BuildMod(const FString& ModName, bool bIsSameContentError)
+bool UModBuilder::PrepareBuild(FModBuildContext& Context)
 {
+	check(IsInGameThread());
+
 	const UModdingExSettings* Settings = GetDefault<UModdingExSettings>();
 	const UProjectPackagingSettings* PackagingSettings = GetDefault<UProjectPackagingSettings>();
-	const bool bUseIoStore = PackagingSettings->bUseIoStore;
-
-	FString FinalDestinationDir; 
-
-	SetLiveCoding(false);
+	const FString& ModName = Context.ModName;
+	Context.bUseIoStore = PackagingSettings->bUseIoStore;
+	Context.bSkipIfUnchanged = Settings->bSkipBuildIfUnchanged;
 
 	// --- 1. Common Setup ---
 	if (Settings->bSaveAllBeforeBuilding)
 	{
-		FEditorFileUtils::SaveDirtyPackages(false, true, true, false, false, false);
-		UE_LOG(LogModdingEx, Log, TEXT("Saved all packages"));
+		Context.Profiler.BeginPhase(EModBuildPhase::SavePackages);
+		UModMembershipSubsystem* Membership = GEditor ? GEditor->GetEditorSubsystem<UModMembershipSubsystem>() : nullptr;
+		const EModPackageSaveResult SaveResult = Settings->bOnlySaveModPackages && Membership
+			? Membership->SaveDirtyModPackages(Context.GetModNames(), Context.UnsavedPackages)
+			: EModPackageSaveResult::NotResolved;
+
+		if (SaveResult == EModPackageSaveResult::Saved)
+		{
+			UE_LOG(LogModdingEx, Log, TEXT("Saved the packages of %s"), *FString::Join(Context.GetModNames(), TEXT(", ")));
+			for (const FString& PackageName : Context.UnsavedPackages)
+			{
+				UE_LOG(LogModdingEx, Log, TEXT("Left unrelated package unsaved: %s"), *PackageName);
+				Context.Warnings.Add(FString::Printf(TEXT("Left unrelated package unsaved: %s"), *PackageName));
+			}
+		}
+		else if (SaveResult == EModPackageSaveResult::Failed)
+		{
+			// Saving everything instead would touch exactly the unrelated packages this mode leaves alone
+			Context.Profiler.EndPhase();
+			ShowBuildError(Context, TEXT("Saving the mod's packages failed or was cancelled, the build would use the last saved assets."));
+			return false;
+		}
+		else
+		{
+			FEditorFileUtils::SaveDirtyPackages(false, true, true, false, false, false);
+			UE_LOG(LogModdingEx, Log, TEXT("Saved all packages"));
+		}
+		Context.Profiler.EndPhase();
 	}
 
-	if (!GetOutputFolder(true, FinalDestinationDir)) 
+	if (!GetOutputFolder(true, Context.FinalDestinationDir))
 	{
-		if (FMessageDialog::Open(EAppMsgType::YesNo, FText::FromString(
+		if (!IsRunningCommandlet() && FMessageDialog::Open(EAppMsgType::YesNo, FText::FromString(
 			"Game directory is not set or does not exist in ModdingEx settings. This is required for the output path.\n\nGo to Settings?")) == EAppReturnType::Yes)
 	{
 			FModuleManager::LoadModuleChecked<ISettingsModule>("Settings").ShowViewer("Project", "Plugins", "ModdingEx");
@@ -105,266 +227,1111 @@ bool UModBuilder::BuildMod(const FString& ModName, bool bIsSameContentError)
 	}
 
 	// --- 2. Define Paths & Platform ---
-	const FString PlatformName = TEXT("Win64");
-	FString UatPath = FPaths::ConvertRelativePathToFull(FPaths::EngineDir() / TEXT("Build/BatchFiles/RunUAT.bat"));
-	if (!FPaths::FileExists(UatPath))
+#if PLATFORM_WINDOWS
+	Context.UatPath = FPaths::ConvertRelativePathToFull(FPaths::EngineDir() / TEXT("Build/BatchFiles/RunUAT.bat"));
+#else
+	Context.UatPath = FPaths::ConvertRelativePathToFull(FPaths::EngineDir() / TEXT("Build/BatchFiles/RunUAT.sh"));
+#endif
+	if (!FPaths::FileExists(Context.UatPath))
 	{
-		UE_LOG(LogModdingEx, Error, TEXT("RunUAT.bat not found at expected location: %s"), *UatPath);
-		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(TEXT("RunUAT.bat not found. Ensure Engine installation is correct.")));
+		ShowBuildError(Context, FString::Format(TEXT("{0} not found at {1}. Ensure Engine installation is correct."), {FPaths::GetCleanFilename(Context.UatPath), Context.UatPath}));
 		return false;
 	}
 	FString ProjectPath = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
-	FString TempStagingDir = FPaths::ProjectIntermediateDir() / TEXT("ModdingExStaging") / FGuid::NewGuid().ToString();
+
+	Context.bPersistentStaging = Settings->bUsePersistentStaging;
+
+	// Resolved before staging, the referenced packages outside the mod dirs take staging space too
+	bool bHasCookSet = true;
+	UModMembershipSubsystem* Membership = GEditor ? GEditor->GetEditorSubsystem<UModMembershipSubsystem>() : nullptr;
+	for (const FString& CookModName : Context.GetModNames())
+	{
+		bHasCookSet &= Membership ? Membership->GetModPackages(CookModName, Context.CookSet) : ModCookSet::Collect(CookModName, Context.CookSet);
+	}
+
+	// Resolved here on the game thread, the up to date check and the cache key hash these files on the build thread.
+	// The cooker follows the references with -CookDir as well, so they stay inputs if the list falls back to it
+	for (const FName& PackageName : Context.CookSet.ExternalPackages)
+	{
+		FString PackageFile;
+		if (!FPackageName::DoesPackageExist(PackageName.ToString(), &PackageFile))
+		{
+			PackageFile = FPackageName::LongPackageNameToFilename(PackageName.ToString(), FPackageName::GetAssetPackageExtension());
+		}
+		Context.ExternalPackageFiles.Add(PackageFile);
+	}
+
+	// Fail before UAT starts if the staging location is too full for the build, a cook running out of space fails late and leaves partial files
+	const int64 RequiredStagingBytes = ModStaging::EstimateRequiredBytes(Context.GetModNames(), Context.ExternalPackageFiles);
+	bool bStagingOnRamDisk = false;
+	const FString StagingRoot = ModStaging::ResolveRoot(RequiredStagingBytes, Context.bPersistentStaging, bStagingOnRamDisk);
+
+	FString StagingSpaceError;
+	if (!ModStaging::HasFreeSpace(StagingRoot, RequiredStagingBytes, StagingSpaceError))
+	{
+		ShowBuildError(Context, StagingSpaceError);
+		return false;
+	}
+
+	if (bStagingOnRamDisk)
+	{
+		UE_LOG(LogModdingEx, Log, TEXT("Staging on the RAM disk at %s"), *StagingRoot);
+	}
 
 	IFileManager& FileManager = IFileManager::Get();
-	if (FPaths::DirectoryExists(TempStagingDir))
+	if (Context.bPersistentStaging)
 	{
-		if (!FileManager.DeleteDirectory(*TempStagingDir, false, true)) {
-             UE_LOG(LogModdingEx, Warning, TEXT("Could not clean existing temp staging directory: %s"), *TempStagingDir);
+		// Batch builds cook a different set of mods each time, so they get their own dirs
+		const FString StagingName = Context.IsBatch() ? TEXT("_Batch") : ModName;
+		Context.TempStagingDir = StagingRoot / TEXT("ModdingExStaging") / StagingName;
+		Context.CookOutputDir = StagingRoot / TEXT("ModdingExCooked") / StagingName;
+
+		// Cooked and staged files are reused, but paks are always rewritten and stale chunks would confuse the output lookup
+		FileManager.IterateDirectory(*Context.TempStagingDir, [&FileManager](const TCHAR* FilenameOrDirectory, bool bIsDirectory)
+		{
+			if (bIsDirectory)
+			{
+				FileManager.DeleteDirectory(*(FString(FilenameOrDirectory) / FApp::GetProjectName() / TEXT("Content/Paks")), false, true);
+			}
+			return true;
+		});
+		FileManager.DeleteDirectory(*(Context.TempStagingDir / FApp::GetProjectName() / TEXT("Content/Paks")), false, true);
+	}
+	else
+	{
+		// Cooked next to the staged files instead of Saved/Cooked, so builds running side by side don't cook over each other
+		Context.TempStagingDir = StagingRoot / TEXT("ModdingExStaging") / FGuid::NewGuid().ToString();
+		Context.CookOutputDir = Context.TempStagingDir / TEXT("_Cooked");
+	}
+
+	if (!Context.bPersistentStaging && FPaths::DirectoryExists(Context.TempStagingDir))
+	{
+		if (!FileManager.DeleteDirectory(*Context.TempStagingDir, false, true)) {
+             UE_LOG(LogModdingEx, Warning, TEXT("Could not clean existing temp staging directory: %s"), *Context.TempStagingDir);
         }
 	}
-	if (!FileManager.MakeDirectory(*TempStagingDir, true))
+	if (!FileManager.MakeDirectory(*Context.TempStagingDir, true))
 	{
-		UE_LOG(LogModdingEx, Error, TEXT("Failed to create temporary staging directory: %s"), *TempStagingDir);
-		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(FString::Format(TEXT("Failed to create temporary staging directory: {0}"), {TempStagingDir})));
+		ShowBuildError(Context, FString::Format(TEXT("Failed to create temporary staging directory: {0}"), {Context.TempStagingDir}));
 		return false;
 	}
 
-	UE_LOG(LogModdingEx, Log, TEXT("Using temp staging directory: %s"), *TempStagingDir);
-	UE_LOG(LogModdingEx, Log, TEXT("Using final destination directory: %s"), *FinalDestinationDir);
+	UE_LOG(LogModdingEx, Log, TEXT("Using temp staging directory: %s"), *Context.TempStagingDir);
+	UE_LOG(LogModdingEx, Log, TEXT("Using final destination directory: %s"), *Context.FinalDestinationDir);
 
-	FScopedSlowTask SlowTask(2, FText::FromString(FString::Format(TEXT("Building {0} via UAT ({1})"), {ModName, bUseIoStore ? TEXT("IO Store + Pak") : TEXT("Pak File")})));
-	SlowTask.MakeDialog();
+	switch (Settings->CodeBuild)
+	{
+	case EModCodeBuild::Always:
+		Context.bBuildCode = true;
+		break;
+	case EModCodeBuild::Never:
+		Context.bBuildCode = false;
+		break;
+	default:
+		Context.bBuildCode = IsCodeBuildNeeded(Context.PlatformName);
+		break;
+	}
 
 	// --- 3. Construct UAT Arguments ---
-	SlowTask.EnterProgressFrame(1, FText::FromString("Running Unreal Automation Tool (BuildCookRun)"));
-
-	FString UatArgs = TEXT("BuildCookRun");
+	FString& UatArgs = Context.UatArgs;
+	UatArgs = TEXT("BuildCookRun");
 	UatArgs += FString::Printf(TEXT(" -project=\"%s\""), *ProjectPath);
-	UatArgs += FString::Printf(TEXT(" -platform=%s"), *PlatformName); 
-	UatArgs += TEXT(" -clientconfig=Shipping"); 
+	UatArgs += FString::Printf(TEXT(" -platform=%s"), *Context.PlatformName);
+	UatArgs += TEXT(" -clientconfig=Shipping");
 	UatArgs += TEXT(" -cook");
 	UatArgs += TEXT(" -stage");
-	UatArgs += FString::Printf(TEXT(" -stagingdirectory=\"%s\""), *TempStagingDir);
-	UatArgs += TEXT(" -package"); 
+	UatArgs += FString::Printf(TEXT(" -stagingdirectory=\"%s\""), *Context.TempStagingDir);
+	UatArgs += TEXT(" -package");
 	UatArgs += TEXT(" -pak");
 	UatArgs += TEXT(" -SkipCookingEditorContent");
 
-	if (bUseIoStore) {
+	if (Context.bUseIoStore) {
 		UatArgs += TEXT(" -iostore");
 	}
 
-	FString ModContentDir = FPaths::ProjectContentDir() / TEXT("Mods") / ModName;
-	if(FPaths::DirectoryExists(ModContentDir))
+	// Cook exactly the packages the mods reference, the whole mod dirs are only cooked if that set can't be resolved
+	TArray<FString> CookPackages;
+	for (const FName& PackageName : Context.CookSet.Packages)
+	{
+		CookPackages.Add(PackageName.ToString());
+	}
+	const FString CookPackageList = FString::Join(CookPackages, TEXT("+"));
+
+	if (bHasCookSet && CookPackageList.Len() <= ModCookSet::MaxPackageListLength)
+	{
+		UE_LOG(LogModdingEx, Log, TEXT("Cooking %d packages resolved from the Asset Registry"), CookPackages.Num());
+		for (const FName& PackageName : Context.CookSet.ExternalPackages)
+		{
+			UE_LOG(LogModdingEx, Warning, TEXT("Referenced asset is outside the mod folder and will be cooked into the mod: %s"), *PackageName.ToString());
+			Context.Warnings.Add(FString::Printf(TEXT("Referenced asset is outside the mod folder: %s"), *PackageName.ToString()));
+		}
+
+		UatArgs += FString::Printf(TEXT(" -MapsToCook=\"%s\""), *CookPackageList);
+		Context.bCookSetResolved = true;
+	}
+	else
+	{
+		if (bHasCookSet)
+		{
+			UE_LOG(LogModdingEx, Warning, TEXT("Cook set of %d packages is too long for the command line, cooking the mod directories instead"), CookPackages.Num());
+		}
+		else
+		{
+			// Assets referenced from outside the mod dirs aren't known, so unchanged mod files don't mean an unchanged pak
+			UE_LOG(LogModdingEx, Log, TEXT("Referenced assets couldn't be resolved, building without the up to date check and the build cache"));
+			Context.bForceRebuild = true;
+		}
+		Context.CookSet = FModCookSet();
+
+		TArray<FString> CookDirs;
+		for (const FString& CookModName : Context.GetModNames())
+		{
+			FString ModContentDir = FPaths::ProjectContentDir() / TEXT("Mods") / CookModName;
+			if(FPaths::DirectoryExists(ModContentDir))
+			{
+				CookDirs.Add(ModContentDir);
+			}
+			else
+			{
+				UE_LOG(LogModdingEx, Warning, TEXT("Mod content directory not found, cannot specify -CookDir: %s"), *ModContentDir);
+			}
+		}
+
+		if (!CookDirs.IsEmpty())
+		{
+			UatArgs += FString::Printf(TEXT(" -CookDir=\"%s\""), *FString::Join(CookDirs, TEXT("+")));
+		}
+	}
+
+	UatArgs += TEXT(" -NoP4");
+	if (Context.bBuildCode) {
+		UatArgs += TEXT(" -build");
+	}
+	UatArgs += TEXT(" -utf8output");
+	UatArgs += TEXT(" -unattended");
+	UatArgs += TEXT(" -nodebuginfo");
+
+	UatArgs += FString::Printf(TEXT(" -CookOutputDir=\"%s\""), *Context.CookOutputDir);
+	if (Context.bPersistentStaging)
+	{
+		UatArgs += TEXT(" -iterativecooking");
+		UatArgs += TEXT(" -nocleanstage");
+	}
+
+	// --- 4. Snapshot for the incremental build check ---
+	FModBuildSettingsSnapshot& BuildSettings = Context.BuildSettings;
+	BuildSettings.EngineVersion = FEngineVersion::Current().ToString();
+	BuildSettings.Platform = Context.PlatformName;
+	BuildSettings.bUseIoStore = Context.bUseIoStore;
+	BuildSettings.bCompressed = PackagingSettings->bCompressed;
+	BuildSettings.CompressionFormats = PackagingSettings->PakFileCompressionFormats;
+	BuildSettings.CompressionOptions = PackagingSettings->PakFileAdditionalCompressionOptions;
+	BuildSettings.OutputDir = Context.FinalDestinationDir;
+
+	Context.bHasPreviousManifest = !Context.IsBatch() && ModBuildManifest::Load(ModName, Context.PreviousManifest);
+
+	Context.Progress.Start(Context.TempStagingDir, FModBuildProgress::FindPreviousRecord(FString::Join(Context.GetModNames(), TEXT("+"))));
+
+	if (Context.bBuildCode)
+	{
+		SetLiveCoding(false);
+	}
+
+	return true;
+}
+
+bool UModBuilder::IsBuildUpToDate(FModBuildContext& Context)
+{
+	// Manifests are per mod, batch builds always cook
+	if (Context.IsBatch())
+	{
+		return false;
+	}
+
+	ModBuildManifest::CollectInputs(Context.ModName, Context.ExternalPackageFiles, Context.bHasPreviousManifest ? &Context.PreviousManifest : nullptr, Context.Inputs);
+
+	if (Context.bForceRebuild || !Context.bHasPreviousManifest)
+	{
+		return false;
+	}
+
+	if (!ModBuildManifest::AreInputsEqual(Context.PreviousManifest.Inputs, Context.Inputs))
+	{
+		return false;
+	}
+
+	const FModBuildSettingsSnapshot& PreviousSettings = Context.PreviousManifest.Settings;
+	const bool bSameCook = PreviousSettings.EngineVersion == Context.BuildSettings.EngineVersion && PreviousSettings.Platform == Context.BuildSettings.Platform;
+
+	if (PreviousSettings != Context.BuildSettings)
+	{
+		UE_LOG(LogModdingEx, Log, TEXT("Build settings of '%s' changed since the last build"), *Context.ModName);
+		Context.bPackageOnly = bSameCook && ModPackager::HasCookedOutput(Context);
+		return false;
+	}
+
+	if (!ModBuildManifest::AreOutputsDeployed(Context.PreviousManifest))
+	{
+		UE_LOG(LogModdingEx, Log, TEXT("Deployed files of '%s' were changed or removed since the last build"), *Context.ModName);
+		Context.bPackageOnly = ModPackager::HasCookedOutput(Context);
+		return false;
+	}
+
+	if (!Context.bSkipIfUnchanged)
+	{
+		UE_LOG(LogModdingEx, Log, TEXT("No asset of '%s' changed since the last build, building anyway since skipping is off"), *Context.ModName);
+		Context.bPackageOnly = ModPackager::HasCookedOutput(Context);
+		return false;
+	}
+
+	UE_LOG(LogModdingEx, Log, TEXT("No asset of '%s' changed since the last build, skipping UAT"), *Context.ModName);
+	Context.bUpToDate = true;
+	return true;
+}
+
+bool UModBuilder::ExecuteBuild(FModBuildContext& Context, FModBuildProcess& Process)
+{
+	if (IsBuildUpToDate(Context))
+	{
+		return true;
+	}
+
+	if (Context.bCancelRequested)
+	{
+		Context.ErrorMessage = TEXT("Build was cancelled");
+		return false;
+	}
+
+	if (RestoreFromCache(Context))
+	{
+		CompareWithDeployed(Context);
+		return DeployBuildOutput(Context);
+	}
+
+	// Assets are unchanged and still cooked from the last build, only the pak needs to be written again
+	if (Context.bPackageOnly)
+	{
+		UE_LOG(LogModdingEx, Log, TEXT("Assets of '%s' are unchanged, packing the cooked output of the last build"), *Context.ModName);
+		if (!ModPackager::Package(Context, Process.OnOutput))
+		{
+			return false;
+		}
+
+		StoreInCache(Context);
+		CompareWithDeployed(Context);
+		return DeployBuildOutput(Context);
+	}
+
+	if (!RunUat(Context, Process) || !CollectBuildOutput(Context))
+	{
+		return false;
+	}
+
+	StoreInCache(Context);
+	return DeployBuildOutput(Context);
+}
+
+bool UModBuilder::RestoreFromCache(FModBuildContext& Context)
+{
+	if (!GetDefault<UModdingExSettings>()->bUseBuildCache)
+	{
+		return false;
+	}
+
+	Context.CacheKey = ModBuildCache::ComputeKey(Context);
+	if (Context.CacheKey.IsEmpty() || Context.bForceRebuild)
+	{
+		return false;
+	}
+
+	TArray<FString> FileNames = { Context.ModName + TEXT(".pak") };
+	if (Context.bUseIoStore)
+	{
+		FileNames.Add(Context.ModName + TEXT(".utoc"));
+		FileNames.Add(Context.ModName + TEXT(".ucas"));
+	}
+
+	TArray<FString> CachedFiles;
+	if (!ModBuildCache::Find(Context.CacheKey, FileNames, CachedFiles))
+	{
+		return false;
+	}
+
+	UE_LOG(LogModdingEx, Log, TEXT("'%s' was built with the same assets and settings before, deploying cache entry %s"), *Context.ModName, *Context.CacheKey);
+
+	Context.OutputFiles.Empty();
+	for (int32 Index = 0; Index < FileNames.Num(); Index++)
+	{
+		Context.OutputFiles.Add({ CachedFiles[Index], Context.FinalDestinationDir / FileNames[Index] });
+	}
+
+	Context.bFromCache = true;
+	return true;
+}
+
+void UModBuilder::StoreInCache(const FModBuildContext& Context)
+{
+	if (Context.CacheKey.IsEmpty())
+	{
+		return;
+	}
+
+	// Stored before deploying, the deploy may move the staged files away
+	if (ModBuildCache::Store(Context.CacheKey, Context.OutputFiles))
+	{
+		ModBuildCache::Evict(int64(GetDefault<UModdingExSettings>()->BuildCacheSizeMB) * 1024 * 1024, Context.CacheKey);
+	}
+}
+
+bool UModBuilder::DeployBuildOutput(FModBuildContext& Context)
+{
+	// A cancelled build must not replace what is deployed, even if its output is complete
+	if (Context.bCancelRequested)
+	{
+		Context.ErrorMessage = TEXT("Build was cancelled");
+		return false;
+	}
+
+	if (Context.bContentUnchanged)
+	{
+		UE_LOG(LogModdingEx, Log, TEXT("Content of '%s' is unchanged, skipping deploy to: %s"), *Context.ModName, *Context.FinalDestinationDir);
+		return true;
+	}
+
+	const UModdingExSettings* Settings = GetDefault<UModdingExSettings>();
+
+	FModDeployOptions Options;
+	Options.LockTimeoutSeconds = Settings->DeployLockTimeout;
+	if (Settings->bShouldKillProcesses)
+	{
+		Options.ProcessesToKill = Settings->ProcessesToKill;
+	}
+	Options.bKeepSources = Context.bFromCache;
+	Options.ShouldCancel = [&Context] { return Context.bCancelRequested.load(); };
+	Options.OnStatus = [&Context](const FString& Status) { Context.Progress.SetDetail(Status); };
+
+	UE_LOG(LogModdingEx, Log, TEXT("Deploying output files to: %s"), *Context.FinalDestinationDir);
+	Context.Profiler.BeginPhase(EModBuildPhase::Copy);
+	const bool bDeployed = ModDeploy::DeployFilesAtomic(Context.OutputFiles, Options, Context.ErrorMessage);
+	Context.Profiler.EndPhase();
+	Context.Progress.SetDetail(FString());
+
+	return bDeployed;
+}
+
+void UModBuilder::SaveBuildManifest(const FModBuildContext& Context)
+{
+	if (Context.IsBatch())
+	{
+		return;
+	}
+
+	FModBuildManifest Manifest;
+	Manifest.Settings = Context.BuildSettings;
+	Manifest.Inputs = Context.Inputs;
+
+	// A build restored from the cache left the cook dir as the build before it cooked it, packing it again would be stale
+	if (Context.bPersistentStaging && !Context.bFromCache)
+	{
+		Manifest.CookOutputDir = FPaths::ConvertRelativePathToFull(Context.CookOutputDir);
+	}
+
+	TArray<FString> DeployedFiles;
+	for (const FModBuildOutputFile& OutputFile : Context.OutputFiles)
+	{
+		DeployedFiles.Add(OutputFile.DestPath);
+	}
+	ModBuildManifest::CollectOutputs(DeployedFiles, Manifest.Outputs);
+
+	ModBuildManifest::Save(Context.ModName, Manifest);
+}
+
+bool UModBuilder::RunUat(FModBuildContext& Context, FModBuildProcess& Process)
+{
+	UE_LOG(LogModdingEx, Log, TEXT("Executing Step: UAT BuildCookRun"));
+	UE_LOG(LogModdingEx, Log, TEXT("Command: %s %s"), *Process.GetExecutable(), *Process.GetParams());
+
+	Context.Profiler.BeginPhase(EModBuildPhase::Uat);
+
+	// AutomationTool allows one instance per engine install and fails the second build running side by side.
+	// The builds have their own staging and cook dirs, so UAT is told to skip that check
+	Process.Environment.Add(TEXT("uebp_UATMutexNoWait"), TEXT("1"));
+
+	int32 ReturnCode = -1;
+	const bool bStarted = Process.Run(ReturnCode);
+	Context.Profiler.EndPhase();
+
+	if (Process.WasCancelled())
+	{
+		Context.bUatInterrupted = true;
+		Context.ErrorMessage = TEXT("Build was cancelled");
+		return false;
+	}
+
+	if (!bStarted || ReturnCode != 0)
+	{
+		UE_LOG(LogModdingEx, Error, TEXT("Execution failed for 'UAT BuildCookRun'. Return Code: %d"), ReturnCode);
+		Context.ErrorMessage = FString::Format(TEXT("Step 'UAT BuildCookRun' failed (Code: {0}). Check logs for details."), {ReturnCode});
+		return false;
+	}
+
+	UE_LOG(LogModdingEx, Log, TEXT("Execution successful for 'UAT BuildCookRun'."));
+	return true;
+}
+
+bool UModBuilder::CollectBuildOutput(FModBuildContext& Context)
+{
+	IFileManager& FileManager = IFileManager::Get();
+	const FString& ModName = Context.ModName;
+	const FString& TempStagingDir = Context.TempStagingDir;
+	const FString& FinalDestinationDir = Context.FinalDestinationDir;
+	const FString& PlatformName = Context.PlatformName;
+
+	// StagedPaksDir determination logic remains the same...
+	FString StagedPaksDir = TempStagingDir / PlatformName / FApp::GetProjectName() / TEXT("Content/Paks"); // Use PlatformName variable
+
+	// Adjust StagedPaksDir if initial path doesn't exist (same as before)
+	if (!FPaths::DirectoryExists(StagedPaksDir))
+	{
+		// Fallback logic for directory structure variations
+		StagedPaksDir = TempStagingDir / FApp::GetProjectName() / TEXT("Content/Paks"); // Try without PlatformName
+		if (!FPaths::DirectoryExists(StagedPaksDir)) {
+			StagedPaksDir = TempStagingDir / TEXT("Windows") / FApp::GetProjectName() / TEXT("Content/Paks"); // Try specific "Windows" if PlatformName didn't work
+		}
+		// Add more fallbacks if needed based on observed UAT output structures
+
+		if (!FPaths::DirectoryExists(StagedPaksDir)) {
+			UE_LOG(LogModdingEx, Error, TEXT("Staged Paks directory not found after UAT run in expected locations. Check UAT logs. Tried paths ending with: %s"),
+				*(PlatformName / FApp::GetProjectName() / TEXT("Content/Paks"))); // Simplified error message
+			Context.ErrorMessage = TEXT("Build process seemed successful, but the output Paks directory was not found in the staging area. Check UAT logs.");
+			return false;
+		} else {
+             UE_LOG(LogModdingEx, Warning, TEXT("Staged Paks directory found at alternate location: %s"), *StagedPaksDir);
+        }
+	}
+
+	UE_LOG(LogModdingEx, Log, TEXT("Looking for output files in: %s"), *StagedPaksDir);
+
+	TArray<FString> Extensions = { TEXT(".pak") };
+	if (Context.bUseIoStore)
+	{
+		Extensions.Add(TEXT(".utoc"));
+		Extensions.Add(TEXT(".ucas"));
+	}
+
+	// Add the pak (and IoStore container) of a chunk, deployed under the name of the mod
+	auto AddChunkOutput = [&](const FString& BaseName, const FString& OutputModName)
+	{
+		for (const FString& Extension : Extensions)
+		{
+			const FString SourcePath = StagedPaksDir / (BaseName + Extension);
+			if (!FileManager.FileExists(*SourcePath))
+			{
+				UE_LOG(LogModdingEx, Error, TEXT("Expected output file '%s' not found in staging directory!"), *(BaseName + Extension));
+				Context.ErrorMessage = TEXT("Build completed, but one or more output files were not found in the staging directory. Check logs.");
+				return false;
+			}
+
+			Context.OutputFiles.Add({ SourcePath, FinalDestinationDir / (OutputModName + Extension) });
+		}
+		return true;
+	};
+
+	TArray<FString> FoundFiles;
+	FileManager.FindFiles(FoundFiles, *StagedPaksDir, TEXT("*.pak")); // Find all pak files first
+
+	Context.OutputFiles.Empty();
+
+	if (Context.IsBatch())
+	{
+		// Every mod has its own chunk, split the output by chunk ID instead of guessing
+		for (const TPair<FString, int32>& ModChunk : Context.BatchChunkIds)
+		{
+			const FString ChunkPrefix = FString::Printf(TEXT("pakchunk%d"), ModChunk.Value);
+			const FString* ChunkPakFilename = FoundFiles.FindByPredicate([&ChunkPrefix](const FString& PakFilename)
+			{
+				const FString BaseName = FPaths::GetBaseFilename(PakFilename);
+				return BaseName == ChunkPrefix || BaseName.StartsWith(ChunkPrefix + TEXT("-"));
+			});
+
+			if (!ChunkPakFilename)
+			{
+				UE_LOG(LogModdingEx, Error, TEXT("No pak for chunk %d of mod '%s' found in staging directory: %s"), ModChunk.Value, *ModChunk.Key, *StagedPaksDir);
+				Context.ErrorMessage = FString::Format(TEXT("Build completed, but no pak was created for mod '{0}' (chunk {1}). Check that Generate Chunks is enabled in the packaging settings."), { ModChunk.Key, ModChunk.Value });
+				return false;
+			}
+
+			if (!AddChunkOutput(FPaths::GetBaseFilename(*ChunkPakFilename), ModChunk.Key))
+			{
+				return false;
+			}
+		}
+	}
+	else
+	{
+		// --- Find Highest Pakchunk Logic ---
+		int32 HighestChunkNum = -1;
+		FString HighestChunkPakFilename;
+		FString BasePlatformString; // String like "-windows" or "-Win64" found in the filename
+
+		const FRegexPattern PakChunkPattern(TEXT("^pakchunk(\\d+)(-([^-.]+))?\\.pak$"));
+
+		for (const FString& PakFilename : FoundFiles)
+		{
+			FRegexMatcher Matcher(PakChunkPattern, PakFilename);
+			if (Matcher.FindNext())
+			{
+				FString ChunkNumStr = Matcher.GetCaptureGroup(1);
+				int32 CurrentChunkNum = FCString::Atoi(*ChunkNumStr);
+
+	            // Optional: Capture the platform string part for robustness
+	            FString CurrentPlatformPart = Matcher.GetCaptureGroup(2); // Includes the leading hyphen, e.g., "-Windows"
+
+				UE_LOG(LogModdingEx, Verbose, TEXT("Found pakchunk file: %s, Chunk Number: %d, Platform Part: %s"), *PakFilename, CurrentChunkNum, *CurrentPlatformPart);
+
+				if (CurrentChunkNum > HighestChunkNum)
+				{
+					HighestChunkNum = CurrentChunkNum;
+					HighestChunkPakFilename = PakFilename;
+	                BasePlatformString = CurrentPlatformPart; // Store the platform string associated with the highest chunk
+				}
+			}
+	        else
+	        {
+	             UE_LOG(LogModdingEx, Log, TEXT("Found pak file not matching pakchunk pattern, ignoring: %s"), *PakFilename);
+	             // This might be the base 'ProjectName.pak' or similar, which we might want to ignore anyway
+	        }
+		}
+
+		if (HighestChunkNum == -1 || HighestChunkPakFilename.IsEmpty())
+		{
+			UE_LOG(LogModdingEx, Error, TEXT("No files matching 'pakchunkN-Platform.pak' pattern found in staging directory: %s"), *StagedPaksDir);
+			Context.ErrorMessage = TEXT("Build completed, but one or more output files were not found in the staging directory. Check logs.");
+			return false;
+		}
+
+		UE_LOG(LogModdingEx, Log, TEXT("Highest pakchunk found: %d (%s). Associated platform string: '%s'"), HighestChunkNum, *HighestChunkPakFilename, *BasePlatformString);
+
+	    // Construct expected utoc and ucas names based on the highest pak chunk file found
+	    const FString BaseName = FPaths::GetBaseFilename(HighestChunkPakFilename); // e.g., "pakchunk101-Windows"
+
+		// Destination is renamed using ModName
+		if (!AddChunkOutput(BaseName, ModName))
+		{
+			return false;
+		}
+	}
+
+	CompareWithDeployed(Context);
+	return true;
+}
+
+void UModBuilder::CompareWithDeployed(FModBuildContext& Context)
+{
+	// Compare against what is currently deployed, hashing happens here so it stays off the game thread
+	Context.bContentUnchanged = false;
+	if (Context.bCheckHash)
+	{
+		Context.bContentUnchanged = true;
+		for (const FModBuildOutputFile& OutputFile : Context.OutputFiles)
+		{
+			if (!ModHash::AreFilesEqual(OutputFile.SourcePath, OutputFile.DestPath))
+			{
+				Context.bContentUnchanged = false;
+				break;
+			}
+		}
+
+		UE_LOG(LogModdingEx, Log, TEXT("Hash check for '%s': content %s"), *Context.ModName, Context.bContentUnchanged ? TEXT("is unchanged") : TEXT("has changed"));
+	}
+}
+
+// Lists the dirty packages that were left unsaved because they don't belong to the built mods
+FString GetUnsavedPackagesNote(const FModBuildContext& Context)
+{
+	constexpr int32 MaxListed = 5;
+	if (Context.UnsavedPackages.IsEmpty())
+	{
+		return FString();
+	}
+
+	TArray<FString> Listed(Context.UnsavedPackages.GetData(), FMath::Min(Context.UnsavedPackages.Num(), MaxListed));
+	FString Note = FString::Printf(TEXT("\nNot saved, unrelated to the mod: %s"), *FString::Join(Listed, TEXT(", ")));
+	if (Context.UnsavedPackages.Num() > MaxListed)
+	{
+		Note += FString::Printf(TEXT(" and %d more"), Context.UnsavedPackages.Num() - MaxListed);
+	}
+	return Note;
+}
+
+// Remove what a cancelled build left behind, the deployed files were never touched
+void CleanupCancelledBuild(FModBuildContext& Context)
+{
+	IFileManager& FileManager = IFileManager::Get();
+
+	// Staged files are cheap to recreate, so even persistent staging dirs are cleared
+	UE_LOG(LogModdingEx, Log, TEXT("Removing the staging directory of the cancelled build: %s"), *Context.TempStagingDir);
+	FileManager.DeleteDirectory(*Context.TempStagingDir, false, true);
+
+	// The persistent cook dir survives, wiping it would turn the next build after every cancel (the watcher cancels on each save)
+	// into a full cook. Packages of a killed cooker aren't in its asset registry yet, which is only written when the cook finishes,
+	// so the next iterative cook cooks them again. The manifest is deleted below, so they're never packed without cooking either
+	if (Context.bUatInterrupted && !Context.bPersistentStaging && !Context.CookOutputDir.IsEmpty())
+	{
+		UE_LOG(LogModdingEx, Log, TEXT("Removing the cook directory of the interrupted cook: %s"), *Context.CookOutputDir);
+		FileManager.DeleteDirectory(*Context.CookOutputDir, false, true);
+	}
+
+	if (!Context.IsBatch())
+	{
+		ModBuildManifest::Delete(Context.ModName);
+	}
+
+	const FText Text = FText::FromString(FString::Format(TEXT("Build of {0} was cancelled"), {Context.IsBatch() ? FString::Join(Context.GetModNames(), TEXT(", ")) : Context.ModName}));
+	UE_LOG(LogModdingEx, Display, TEXT("%s"), *Text.ToString());
+
+	if (Context.Notification.IsValid())
+	{
+		Context.Notification->Complete(false, Text);
+		Context.Notification.Reset();
+	}
+	else
+	{
+		Notifications::ShowFailNotification(Text, false);
+	}
+}
+
+// Break the deployed paks down by package and compare them against the last build, returns the growth worth a look
+FString UpdateSizeReports(FModBuildContext& Context)
+{
+	const UModdingExSettings* Settings = GetDefault<UModdingExSettings>();
+	if (!Settings->bGenerateSizeReport)
+	{
+		return FString();
+	}
+
+	FString Note;
+	for (const FString& ModName : Context.GetModNames())
+	{
+		FModSizeReport Report;
+		if (!ModSizeReport::Generate(ModName, Context.FinalDestinationDir / (ModName + TEXT(".pak")), Report))
+		{
+			continue;
+		}
+
+		ModSizeReport::LogTopContributors(Report, Settings->SizeReportTopCount);
+
+		FModSizeReport PreviousReport;
+		if (ModSizeReport::Load(ModName, PreviousReport))
+		{
+			const FString Growth = ModSizeReport::DescribeGrowth(PreviousReport, Report, Settings->SizeGrowthWarningPercent, 3);
+			if (!Growth.IsEmpty())
+			{
+				UE_LOG(LogModdingEx, Warning, TEXT("'%s': %s"), *ModName, *Growth);
+				Context.Warnings.Add(FString::Printf(TEXT("'%s': %s"), *ModName, *Growth));
+				Note += TEXT("\n") + (Context.IsBatch() ? ModName + TEXT(": ") : FString()) + Growth;
+			}
+		}
+
+		ModSizeReport::Save(ModName, Report);
+	}
+	return Note;
+}
+
+// Report a successful build through the progress notification, or a standalone one for blocking builds
+void ShowBuildSuccess(FModBuildContext& Context, const FText& Text)
+{
+	UE_LOG(LogModdingEx, Display, TEXT("%s"), *Text.ToString());
+
+	if (IsRunningCommandlet())
+	{
+		return;
+	}
+
+	if (Context.Notification.IsValid())
+	{
+		Context.Notification->Complete(true, Text);
+		Context.Notification.Reset();
+		return;
+	}
+
+	FNotificationInfo Info(Text);
+	Info.Image = FAppStyle::GetBrush(TEXT("LevelEditor.RecompileGameCode"));
+	Info.FadeInDuration = 0.1f;
+	Info.FadeOutDuration = 0.5f;
+	Info.ExpireDuration = 3.5f;
+	Info.bUseThrobber = false;
+	Info.bUseSuccessFailIcons = true;
+	Info.bUseLargeFont = true;
+	Info.bFireAndForget = false;
+	Info.bAllowThrottleWhenFrameRateIsLow = false;
+	const auto NotificationItem = FSlateNotificationManager::Get().AddNotification(Info);
+	NotificationItem->SetCompletionState(SNotificationItem::CS_Success);
+	NotificationItem->ExpireAndFadeout();
+}
+
+EModBuildResult UModBuilder::FinishBuild(FModBuildContext& Context, bool bOutputReady)
+{
+	check(IsInGameThread());
+
+	const FString& ModName = Context.ModName;
+
+	if (Context.bBuildCode)
+	{
+		SetLiveCoding(true);
+	}
+
+	if (!bOutputReady && Context.bCancelRequested)
+	{
+		CleanupCancelledBuild(Context);
+		return EModBuildResult::Cancelled;
+	}
+
+	if (!bOutputReady)
+	{
+		// The cook dir may now hold output of assets the manifest doesn't know about
+		if (!Context.IsBatch())
+		{
+			ModBuildManifest::Delete(ModName);
+		}
+		CleanupStaging(Context);
+		ShowBuildError(Context, Context.ErrorMessage);
+		return EModBuildResult::Failed;
+	}
+
+	if (Context.bUpToDate)
+	{
+		CleanupStaging(Context);
+		ShowBuildSuccess(Context, FText::FromString(FString::Format(TEXT("Mod '{0}' is up to date, skipped building"), { ModName }) + GetUnsavedPackagesNote(Context)));
+		return EModBuildResult::ContentUnchanged;
+	}
+
+	// --- 5. Cleanup, the output was already deployed by the worker ---
+	CleanupStaging(Context);
+
+	SaveBuildManifest(Context);
+
+	if (Context.bContentUnchanged)
+	{
+		ShowBuildSuccess(Context, FText::FromString(FString::Format(TEXT("Mod '{0}' is unchanged, nothing to deploy"), { ModName }) + GetUnsavedPackagesNote(Context)));
+		return EModBuildResult::ContentUnchanged;
+	}
+
+	FString SummaryNote;
+	if (!Context.CookSet.ExternalPackages.IsEmpty())
+	{
+		SummaryNote = FString::Printf(TEXT("\n%d referenced assets outside the mod folder were cooked in, see the log"), Context.CookSet.ExternalPackages.Num());
+	}
+	SummaryNote += UpdateSizeReports(Context);
+	SummaryNote += GetUnsavedPackagesNote(Context);
+
+	if (Context.bFromCache)
+	{
+		ShowBuildSuccess(Context, FText::FromString(FString::Format(TEXT("Mod '{0}' deployed from the build cache ({1})!{2}"), { ModName, Context.bUseIoStore ? TEXT("IO Store + Pak") : TEXT("Pak File"), SummaryNote })));
+	}
+	else if (Context.IsBatch())
+	{
+		ShowBuildSuccess(Context, FText::FromString(FString::Format(TEXT("Mods {0} built successfully ({1})!{2}"), { FString::Join(Context.GetModNames(), TEXT(", ")), Context.bUseIoStore ? TEXT("IO Store + Pak") : TEXT("Pak File"), SummaryNote })));
+	}
+	else
+	{
+		ShowBuildSuccess(Context, FText::FromString(FString::Format(TEXT("Mod '{0}' built successfully ({1})!{2}"), { ModName, Context.bUseIoStore ? TEXT("IO Store + Pak") : TEXT("Pak File"), SummaryNote })));
+	}
+
+	if (GEditor && !IsRunningCommandlet()) {
+	GEditor->PlayEditorSound(TEXT("/Engine/EditorSounds/Notifications/CompileSuccess_Cue.CompileSuccess_Cue"));
+	}
+
+	return EModBuildResult::Built;
+}
+
+// Whether any of the mods of a build is already being built, logs the one that is
+bool IsAnyModBuilding(const TArray<FString>& ModNames)
+{
+	for (const FString& ModName : ModNames)
+	{
+		if (ActiveModBuilds.Contains(ModName))
+		{
+			UE_LOG(LogModdingEx, Warning, TEXT("Mod '%s' is already being built."), *ModName);
+			return true;
+		}
+	}
+	return false;
+}
+
+// Append a finished build to the build history and keep the record on the context for reports
+void RecordBuild(FModBuildContext& Context, EModBuildResult Result)
+{
+	FModBuildRecord Record;
+	Record.Time = FDateTime::Now();
+	Record.ModName = FString::Join(Context.GetModNames(), TEXT("+"));
+	Record.Result = StaticEnum<EModBuildResult>()->GetNameStringByValue((int64)Result);
+
+	const FModBuildSettingsSnapshot& Settings = Context.BuildSettings;
+	Record.EngineVersion = Settings.EngineVersion;
+	Record.SettingsHash = FString::Printf(TEXT("%08x"), FCrc::StrCrc32(*FString::Printf(TEXT("%s|%d|%d|%s|%s|%s"), *Settings.Platform,
+		Settings.bUseIoStore, Settings.bCompressed, *Settings.CompressionFormats, *Settings.CompressionOptions, *Settings.OutputDir)));
+
+	Record.InputFiles = Context.Inputs.Num();
+	for (const FModBuildManifestFile& Input : Context.Inputs)
+	{
+		Record.InputBytes += Input.Size;
+	}
+
+	Context.Profiler.Finish(Record);
+	ModBuildHistory::Append(Record);
+	Context.Record = Record;
+}
+
+FText GetBuildTitle(const FModBuildContext& Context)
+{
+	return FText::FromString(FString::Format(TEXT("Building {0} via UAT ({1})"), {Context.ModName, Context.bUseIoStore ? TEXT("IO Store + Pak") : TEXT("Pak File")}));
+}
+
+EModBuildResult UModBuilder::RunBuildBlocking(FModBuildContext& Context)
+{
+	if (IsAnyModBuilding(Context.GetModNames()) || !PrepareBuild(Context))
 	{
-		UatArgs += FString::Printf(TEXT(" -CookDir=\"%s\""), *ModContentDir);
+		return EModBuildResult::Failed;
 	}
-	else
+
+	for (const FString& ModName : Context.GetModNames())
 	{
-		UE_LOG(LogModdingEx, Warning, TEXT("Mod content directory not found, cannot specify -CookDir: %s"), *ModContentDir);
+		ActiveModBuilds.Add(ModName, &Context);
 	}
 
-	UatArgs += TEXT(" -NoP4");
-	UatArgs += TEXT(" -build");
-	UatArgs += TEXT(" -utf8output");
-	UatArgs += TEXT(" -unattended");
-	UatArgs += TEXT(" -nodebuginfo");
+	FScopedSlowTask SlowTask(100, GetBuildTitle(Context));
+	SlowTask.MakeDialog(true);
 
 	// --- 4. Execute UAT ---
-	
-	if (!ExecProcessAndLog(UatPath, UatArgs, FText::FromString("UAT BuildCookRun")))
-	{
-		FileManager.DeleteDirectory(*TempStagingDir, false, true);
-		return false;
-	}
+	SlowTask.EnterProgressFrame(0, FText::FromString("Running Unreal Automation Tool (BuildCookRun)"));
 
-	// --- 5. Copy Output from Staging Directory ---
-	SlowTask.EnterProgressFrame(1, FText::FromString("Copying build output"));
+	// UAT runs on a worker so the dialog keeps repainting with the latest output line
+	TSharedRef<FModBuildProcess> Process = MakeShared<FModBuildProcess>(Context.UatPath, Context.UatArgs);
+	Process->OnOutput = [&Context](const FString& Line)
+	{
+		LogUatLine(Context, Line);
+		Context.Profiler.ProcessUatLine(Line);
+		Context.Progress.ProcessLine(Line);
+	};
+	Process->ShouldCancel = [&Context] { return Context.bCancelRequested.load(); };
 
-	// StagedPaksDir determination logic remains the same...
-	FString StagedPaksDir = TempStagingDir / PlatformName / FApp::GetProjectName() / TEXT("Content/Paks"); // Use PlatformName variable
+	TFuture<bool> OutputReady = Async(EAsyncExecution::Thread, [&Context, Process]
+	{
+		return ExecuteBuild(Context, *Process);
+	});
 
-	// Adjust StagedPaksDir if initial path doesn't exist (same as before)
-	if (!FPaths::DirectoryExists(StagedPaksDir))
+	// The bar only moves forward, so an estimate that drops back just holds it
+	float ReportedWork = 0.0f;
+	while (!OutputReady.WaitFor(FTimespan::FromMilliseconds(100)))
 	{
-		// Fallback logic for directory structure variations
-		StagedPaksDir = TempStagingDir / FApp::GetProjectName() / TEXT("Content/Paks"); // Try without PlatformName
-		if (!FPaths::DirectoryExists(StagedPaksDir)) {
-			StagedPaksDir = TempStagingDir / TEXT("Windows") / FApp::GetProjectName() / TEXT("Content/Paks"); // Try specific "Windows" if PlatformName didn't work
+		if (SlowTask.ShouldCancel() && !Context.bCancelRequested)
+		{
+			UE_LOG(LogModdingEx, Log, TEXT("Cancelling the build of '%s'"), *Context.ModName);
+			Context.bCancelRequested = true;
 		}
-		// Add more fallbacks if needed based on observed UAT output structures
 
-		if (!FPaths::DirectoryExists(StagedPaksDir)) {
-			UE_LOG(LogModdingEx, Error, TEXT("Staged Paks directory not found after UAT run in expected locations. Check UAT logs. Tried paths ending with: %s"),
-				*(PlatformName / FApp::GetProjectName() / TEXT("Content/Paks"))); // Simplified error message
-			FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(TEXT("Build process seemed successful, but the output Paks directory was not found in the staging area. Check UAT logs.")));
-			FileManager.DeleteDirectory(*TempStagingDir, false, true); // Cleanup temp dir
-			return false;
-		} else {
-             UE_LOG(LogModdingEx, Warning, TEXT("Staged Paks directory found at alternate location: %s"), *StagedPaksDir);
-        }
+		Context.Profiler.SampleMemory();
+
+		const float Fraction = Context.Progress.GetFraction(Context.Profiler);
+		const float NewWork = Fraction >= 0.0f ? FMath::Max(0.0f, Fraction * 99.0f - ReportedWork) : 0.0f;
+		ReportedWork += NewWork;
+		SlowTask.EnterProgressFrame(NewWork, FText::FromString(Context.Progress.GetStatus(Context.Profiler)));
 	}
 
+	SlowTask.EnterProgressFrame(FMath::Max(0.0f, 99.0f - ReportedWork), FText::FromString("Finishing"));
+	const EModBuildResult Result = FinishBuild(Context, OutputReady.Get());
+	RecordBuild(Context, Result);
 
-	UE_LOG(LogModdingEx, Log, TEXT("Looking for output files in: %s"), *StagedPaksDir);
-	UE_LOG(LogModdingEx, Log, TEXT("Copying output files to: %s"), *FinalDestinationDir);
+	for (const FString& ModName : Context.GetModNames())
+	{
+		ActiveModBuilds.Remove(ModName);
+	}
+	return Result;
+}
 
-	// --- Find Highest Pakchunk Logic ---
-	int32 HighestChunkNum = -1;
-	FString HighestChunkPakFilename;
-	FString BasePlatformString; // String like "-windows" or "-Win64" found in the filename
+TFuture<EModBuildResult> UModBuilder::RunBuildAsync(const TSharedRef<FModBuildContext>& Context)
+{
+	check(IsInGameThread());
 
-	TArray<FString> FoundFiles;
-	FileManager.FindFiles(FoundFiles, *StagedPaksDir, TEXT("*.pak")); // Find all pak files first
+	if (IsAnyModBuilding(Context->GetModNames()) || !PrepareBuild(*Context))
+	{
+		return MakeFulfilledPromise<EModBuildResult>(EModBuildResult::Failed).GetFuture();
+	}
 
-	const FRegexPattern PakChunkPattern(TEXT("^pakchunk(\\d+)(-([^-.]+))?\\.pak$"));
+	for (const FString& ModName : Context->GetModNames())
+	{
+		ActiveModBuilds.Add(ModName, &Context.Get());
+	}
 
+	// Commandlets have no Slate, the build only logs there
+	TSharedPtr<FModBuildNotification> Notification;
+	if (!IsRunningCommandlet())
+	{
+		Notification = MakeShared<FModBuildNotification>(GetBuildTitle(*Context), FSimpleDelegate::CreateLambda([WeakContext = Context.ToWeakPtr()]
+		{
+			if (const TSharedPtr<FModBuildContext> PinnedContext = WeakContext.Pin())
+			{
+				UE_LOG(LogModdingEx, Log, TEXT("Cancelling the build of '%s'"), *PinnedContext->ModName);
+				PinnedContext->bCancelRequested = true;
+			}
+		}));
+		Context->Notification = Notification;
+	}
 
-	for (const FString& PakFilename : FoundFiles)
+	const TSharedRef<FModBuildProcess> Process = MakeShared<FModBuildProcess>(Context->UatPath, Context->UatArgs);
+	Process->OnOutput = [Context](const FString& Line)
 	{
-		FRegexMatcher Matcher(PakChunkPattern, PakFilename);
-		if (Matcher.FindNext())
+		LogUatLine(*Context, Line);
+		Context->Profiler.ProcessUatLine(Line);
+		Context->Progress.ProcessLine(Line);
+	};
+	Process->ShouldCancel = [Context] { return Context->bCancelRequested.load(); };
+
+	// Refresh the progress even while UAT is quiet, a frozen ETA would look like a hang
+	const FTSTicker::FDelegateHandle ProgressTicker = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Context, Notification](float)
+	{
+		Context->Profiler.SampleMemory();
+
+		const float Fraction = Context->Progress.GetFraction(Context->Profiler);
+		const FString Status = Context->Progress.GetStatus(Context->Profiler);
+		if (Notification.IsValid())
 		{
-			FString ChunkNumStr = Matcher.GetCaptureGroup(1);
-			int32 CurrentChunkNum = FCString::Atoi(*ChunkNumStr);
+			Notification->SetProgressText(Fraction >= 0.0f ? FString::Printf(TEXT("%d%% - %s"), FMath::FloorToInt(Fraction * 100.0f), *Status) : Status);
+		}
+		return true;
+	}), 0.5f);
+
+	const TSharedRef<TPromise<EModBuildResult>> Promise = MakeShared<TPromise<EModBuildResult>>();
+	TFuture<EModBuildResult> Future = Promise->GetFuture();
 
-            // Optional: Capture the platform string part for robustness
-            FString CurrentPlatformPart = Matcher.GetCaptureGroup(2); // Includes the leading hyphen, e.g., "-Windows"
+	Async(EAsyncExecution::Thread, [Context, Process, Promise, ProgressTicker]
+	{
+		const bool bOutputReady = ExecuteBuild(*Context, *Process);
 
-			UE_LOG(LogModdingEx, Verbose, TEXT("Found pakchunk file: %s, Chunk Number: %d, Platform Part: %s"), *PakFilename, CurrentChunkNum, *CurrentPlatformPart);
+		// The worker already deployed the output, the reports, notifications and continuations happen on the game thread
+		AsyncTask(ENamedThreads::GameThread, [Context, Promise, ProgressTicker, bOutputReady]
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(ProgressTicker);
 
-			if (CurrentChunkNum > HighestChunkNum)
+			const EModBuildResult Result = FinishBuild(*Context, bOutputReady);
+			RecordBuild(*Context, Result);
+			for (const FString& ModName : Context->GetModNames())
 			{
-				HighestChunkNum = CurrentChunkNum;
-				HighestChunkPakFilename = PakFilename;
-                BasePlatformString = CurrentPlatformPart; // Store the platform string associated with the highest chunk
+				ActiveModBuilds.Remove(ModName);
 			}
-		}
-        else
-        {
-             UE_LOG(LogModdingEx, Log, TEXT("Found pak file not matching pakchunk pattern, ignoring: %s"), *PakFilename);
-             // This might be the base 'ProjectName.pak' or similar, which we might want to ignore anyway
-        }
-	}
+			Promise->SetValue(Result);
+		});
+	});
 
-    // --- Copy Files Based on Highest Chunk ---
-	bool bEssentialFilesCopied = false;
+	return Future;
+}
 
-	if (HighestChunkNum != -1 && !HighestChunkPakFilename.IsEmpty())
-	{
-		UE_LOG(LogModdingEx, Log, TEXT("Highest pakchunk found: %d (%s). Associated platform string: '%s'"), HighestChunkNum, *HighestChunkPakFilename, *BasePlatformString);
+bool UModBuilder::IsModBuilding(const FString& ModName)
+{
+	check(IsInGameThread());
+	return ActiveModBuilds.Contains(ModName);
+}
 
-        // Construct expected utoc and ucas names based on the highest pak chunk file found
-        FString BaseName = FPaths::GetBaseFilename(HighestChunkPakFilename); // e.g., "pakchunk101-Windows"
-		FString HighestChunkUtocFilename = BaseName + TEXT(".utoc");
-		FString HighestChunkUcasFilename = BaseName + TEXT(".ucas");
-
-        // Define Source Paths
-        FString SourcePakPath = StagedPaksDir / HighestChunkPakFilename;
-        FString SourceUtocPath = StagedPaksDir / HighestChunkUtocFilename;
-        FString SourceUcasPath = StagedPaksDir / HighestChunkUcasFilename;
-
-        // Define Destination Paths (renamed using ModName)
-        FString DestPakPath = FinalDestinationDir / (ModName + TEXT(".pak"));
-        FString DestUtocPath = FinalDestinationDir / (ModName + TEXT(".utoc"));
-        FString DestUcasPath = FinalDestinationDir / (ModName + TEXT(".ucas"));
-
-        // --- Perform Copying ---
-        bool bPakCopied = false;
-        bool bUtocCopied = false;
-        bool bUcasCopied = false;
-
-        // Copy PAK
-		if (FileManager.FileExists(*SourcePakPath)) {
-			UE_LOG(LogModdingEx, Log, TEXT("Copying PAK: '%s' to '%s'"), *SourcePakPath, *DestPakPath);
-			if (FileManager.Copy(*DestPakPath, *SourcePakPath, true, true, true) == COPY_OK) {
-				bPakCopied = true;
-			} else {
-				UE_LOG(LogModdingEx, Error, TEXT("Failed to copy PAK file: %s -> %s"), *SourcePakPath, *DestPakPath);
-			}
-        } else {
-            UE_LOG(LogModdingEx, Error, TEXT("Highest chunk PAK file '%s' not found in staging directory!"), *HighestChunkPakFilename);
-        }
+void UModBuilder::CancelBuild(const FString& ModName)
+{
+	check(IsInGameThread());
 
-        // Copy UTOC (if IOStore is used)
-		if (bUseIoStore) {
-			if (FileManager.FileExists(*SourceUtocPath)) {
-				UE_LOG(LogModdingEx, Log, TEXT("Copying UTOC: '%s' to '%s'"), *SourceUtocPath, *DestUtocPath);
-				if (FileManager.Copy(*DestUtocPath, *SourceUtocPath, true, true, true) == COPY_OK) {
-					bUtocCopied = true;
-				} else {
-					UE_LOG(LogModdingEx, Error, TEXT("Failed to copy UTOC file: %s -> %s"), *SourceUtocPath, *DestUtocPath);
-				}
-			} else {
-				UE_LOG(LogModdingEx, Error, TEXT("IO Store enabled, but expected UTOC file '%s' not found in staging directory!"), *HighestChunkUtocFilename);
-			}
-        }
+	if (FModBuildContext* const* Context = ActiveModBuilds.Find(ModName))
+	{
+		UE_LOG(LogModdingEx, Log, TEXT("Cancelling the build of '%s'"), *ModName);
+		(*Context)->bCancelRequested = true;
+	}
+}
 
-        // Copy UCAS (if IOStore is used and UTOC was copied)
-		if (bUseIoStore && bUtocCopied) {
-            if (FileManager.FileExists(*SourceUcasPath)) {
-				UE_LOG(LogModdingEx, Log, TEXT("Copying UCAS: '%s' to '%s'"), *SourceUcasPath, *DestUcasPath);
-				if (FileManager.Copy(*DestUcasPath, *SourceUcasPath, true, true, true) == COPY_OK) {
-					bUcasCopied = true;
-				} else {
-					UE_LOG(LogModdingEx, Error, TEXT("Failed to copy UCAS file: %s -> %s"), *SourceUcasPath, *DestUcasPath);
-				}
-			} else {
-				UE_LOG(LogModdingEx, Error, TEXT("IO Store enabled, but expected UCAS file '%s' not found in staging directory!"), *HighestChunkUcasFilename);
-			}
-        } else if (bUseIoStore && !bUtocCopied) {
-            UE_LOG(LogModdingEx, Warning, TEXT("Skipping UCAS file copy because corresponding UTOC was not found or failed to copy."));
-        }
+EModBuildResult UModBuilder::BuildModBlocking(const FString& ModName, bool bCheckHash, bool bForceRebuild)
+{
+	FModBuildContext Context(ModName, bCheckHash && GetDefault<UModdingExSettings>()->bShouldCheckHash);
+	Context.bForceRebuild = bForceRebuild;
+	return RunBuildBlocking(Context);
+}
 
-        // Determine overall success based on required files
-        bEssentialFilesCopied = bPakCopied;
-        if (bUseIoStore) {
-            bEssentialFilesCopied = bEssentialFilesCopied && bUtocCopied && bUcasCopied;
-        }
+bool UModBuilder::BuildMod(const FString& ModName, bool bIsSameContentError)
+{
+	const EModBuildResult Result = BuildModBlocking(ModName);
 
-	} else {
-		UE_LOG(LogModdingEx, Error, TEXT("No files matching 'pakchunkN-Platform.pak' pattern found in staging directory: %s"), *StagedPaksDir);
-        bEssentialFilesCopied = false; // Mark as failure if no pakchunks found
+	if (Result == EModBuildResult::ContentUnchanged && bIsSameContentError)
+	{
+		UE_LOG(LogModdingEx, Warning, TEXT("Content of mod '%s' didn't change since the last build."), *ModName);
+		return false;
 	}
 
+	return Result == EModBuildResult::Built || Result == EModBuildResult::ContentUnchanged;
+}
 
-	// --- 6. Cleanup ---
-	UE_LOG(LogModdingEx, Log, TEXT("Cleaning up temporary staging directory: %s"), *TempStagingDir);
-	if (!FileManager.DeleteDirectory(*TempStagingDir, false, true)) {
-         UE_LOG(LogModdingEx, Warning, TEXT("Could not delete temporary staging directory: %s"), *TempStagingDir);
-    }
+TFuture<EModBuildResult> UModBuilder::BuildModAsync(const FString& ModName, bool bCheckHash, bool bForceRebuild)
+{
+	const TSharedRef<FModBuildContext> Context = MakeShared<FModBuildContext>(ModName, bCheckHash && GetDefault<UModdingExSettings>()->bShouldCheckHash);
+	Context->bForceRebuild = bForceRebuild;
+	return RunBuildAsync(Context);
+}
 
+TFuture<EModBuildResult> UModBuilder::BuildModAsync(const TSharedRef<FModBuildContext>& Context)
+{
+	return RunBuildAsync(Context);
+}
 
-	// --- 7. Final Notification ---
-	if (!bEssentialFilesCopied)
+bool UModBuilder::CreateBatchContext(const TArray<FString>& ModNames, TSharedPtr<FModBuildContext>& OutContext)
+{
+	if (ModNames.IsEmpty())
 	{
-		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(TEXT("Build completed, but one or more output files were not found or failed to copy to the final destination. Check logs.")));
+		UE_LOG(LogModdingEx, Warning, TEXT("No mods given to build."));
 		return false;
-    }
+	}
 
-	FNotificationInfo Info(FText::FromString(FString::Format(TEXT("Mod '{0}' built successfully ({1})!"), { ModName, bUseIoStore ? TEXT("IO Store + Pak") : TEXT("Pak File") })));
-	Info.Image = FAppStyle::GetBrush(TEXT("LevelEditor.RecompileGameCode"));
-	Info.FadeInDuration = 0.1f;
-	Info.FadeOutDuration = 0.5f;
-	Info.ExpireDuration = 3.5f;
-	Info.bUseThrobber = false;
-	Info.bUseSuccessFailIcons = true;
-	Info.bUseLargeFont = true;
-	Info.bFireAndForget = false;
-	Info.bAllowThrottleWhenFrameRateIsLow = false;
-	const auto NotificationItem = FSlateNotificationManager::Get().AddNotification(Info);
-	NotificationItem->SetCompletionState(SNotificationItem::CS_Success);
-	NotificationItem->ExpireAndFadeout();
+	OutContext = MakeShared<FModBuildContext>(FString::Format(TEXT("{0} mods"), {ModNames.Num()}), GetDefault<UModdingExSettings>()->bShouldCheckHash);
 
-	if (GEditor) {
-	GEditor->PlayEditorSound(TEXT("/Engine/EditorSounds/Notifications/CompileSuccess_Cue.CompileSuccess_Cue"));
-	}
+	TMap<int32, FString> ModsByChunk;
+	for (const FString& ModName : ModNames)
+	{
+		int32 ChunkId;
+		if (!ModChunks::ResolveChunkId(ModName, ChunkId))
+		{
+			ShowBuildError(*OutContext, FString::Format(TEXT("Failed to create the chunk label for mod '{0}'. Check logs."), {ModName}));
+			return false;
+		}
+
+		if (const FString* OtherMod = ModsByChunk.Find(ChunkId))
+		{
+			ShowBuildError(*OutContext, FString::Format(TEXT("Mods '{0}' and '{1}' are both assigned to chunk {2}, give one of them a different chunk ID."), {*OtherMod, ModName, ChunkId}));
+			return false;
+		}
 
-	SetLiveCoding(true);
+		ModsByChunk.Add(ChunkId, ModName);
+		OutContext->BatchChunkIds.Add(ModName, ChunkId);
+	}
 
 	return true;
 }
 
+bool UModBuilder::BuildMods(const TArray<FString>& ModNames)
+{
+	TSharedPtr<FModBuildContext> Context;
+	if (!CreateBatchContext(ModNames, Context))
+	{
+		return false;
+	}
+
+	const EModBuildResult Result = RunBuildBlocking(*Context);
+	return Result == EModBuildResult::Built || Result == EModBuildResult::ContentUnchanged;
+}
+
+TFuture<EModBuildResult> UModBuilder::BuildModsAsync(const TArray<FString>& ModNames)
+{
+	TSharedPtr<FModBuildContext> Context;
+	if (!CreateBatchContext(ModNames, Context))
+	{
+		return MakeFulfilledPromise<EModBuildResult>(EModBuildResult::Failed).GetFuture();
+	}
+
+	return RunBuildAsync(Context.ToSharedRef());
+}
+
 bool UModBuilder::GetOutputFolder(bool bIsLogicMod, FString& OutFolder)
 {
 	const auto Settings = GetDefault<UModdingExSettings>();
@@ -432,6 +1399,19 @@ bool UModBuilder::GetOutputFolder(bool bIsLogicMod, FString& OutFolder)
 	return true;
 }
 
+FString UModBuilder::GetZipOutputDir()
+{
+	FString ZipOutputDir = GetDefault<UModdingExSettings>()->ModZipDir.Path;
+	if (ZipOutputDir.IsEmpty()) {
+		ZipOutputDir = FPaths::ProjectSavedDir() / TEXT("Zips");
+		UE_LOG(LogModdingEx, Warning, TEXT("ModZipDir not set in settings, using default: %s"), *ZipOutputDir);
+	} else {
+		ZipOutputDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), ZipOutputDir);
+	}
+    FPaths::NormalizeDirectoryName(ZipOutputDir);
+	return ZipOutputDir;
+}
+
 // Updated ZipModInternal to handle renamed files
 bool UModBuilder::ZipModInternal(const FString& ModName)
 {
@@ -476,24 +1456,20 @@ bool UModBuilder::ZipModInternal(const FString& ModName)
             *ModName,
 			bLookForIoStoreFiles ? TEXT(" or IOStore files") : TEXT(""),
             *OutputDir);
-		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(TEXT("Didn't find any built files named after the mod to zip. Make sure you built the mod successfully.")));
+		if (!IsRunningCommandlet())
+		{
+			FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(TEXT("Didn't find any built files named after the mod to zip. Make sure you built the mod successfully.")));
+		}
 		return false;
 	}
 
 	// --- Prepare Zip File ---
-	FString ZipOutputDir = Settings->ModZipDir.Path;
-	if (ZipOutputDir.IsEmpty()) {
-		ZipOutputDir = FPaths::ProjectSavedDir() / TEXT("Zips");
-		UE_LOG(LogModdingEx, Warning, TEXT("ModZipDir not set in settings, using default: %s"), *ZipOutputDir);
-	} else {
-		ZipOutputDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), ZipOutputDir);
-	}
-    FPaths::NormalizeDirectoryName(ZipOutputDir);
+	const FString ZipOutputDir = GetZipOutputDir();
 
 	if (!FPaths::DirectoryExists(ZipOutputDir) && !FileManager.MakeDirectory(*ZipOutputDir, true))
 	{
 		UE_LOG(LogModdingEx, Error, TEXT("Zips output directory does not exist and could not be created: %s"), *ZipOutputDir);
-		if (FMessageDialog::Open(EAppMsgType::YesNo, FText::FromString(
+		if (!IsRunningCommandlet() && FMessageDialog::Open(EAppMsgType::YesNo, FText::FromString(
 									 "Zip output directory does not exist/could not be created. Go to settings?")) == EAppReturnType::Yes)
 		{
 			FModuleManager::LoadModuleChecked<ISettingsModule>("Settings").ShowViewer("Project", "Plugins", "ModdingEx");
@@ -502,47 +1478,204 @@ bool UModBuilder::ZipModInternal(const FString& ModName)
 	}
 
 	const FString ZipFilePath = ZipOutputDir / (ModName + ".zip");
+
+	FString InputKey;
+	if (Settings->bDeterministicZips)
+	{
+		FilesToArchivePaths.Sort([](const FString& A, const FString& B) { return FPaths::GetCleanFilename(A) < FPaths::GetCleanFilename(B); });
+
+		InputKey = ModZipState::ComputeInputKey(FilesToArchivePaths, Settings->bStoreCompressedFiles);
+		if (ModZipState::IsUpToDate(ZipFilePath, InputKey))
+		{
+			UE_LOG(LogModdingEx, Display, TEXT("Files of '%s' are unchanged since the last zip, keeping %s"), *ModName, *ZipFilePath);
+			if (!IsRunningCommandlet())
+			{
+				Notifications::ShowSuccessNotification(FText::FromString(FString::Format(TEXT("Mod '{0}' is unchanged, kept the existing zip"), {ModName})));
+			}
+			return true;
+		}
+	}
+
 	UE_LOG(LogModdingEx, Log, TEXT("Creating zip file at: %s"), *ZipFilePath);
 
 	// --- Create Zip Archive ---
-	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-    TUniquePtr<IFileHandle> ZipFileHandle(PlatformFile.OpenWrite(*ZipFilePath));
-
-	if (!ZipFileHandle)
+	FModBuildProfiler Profiler;
+	Profiler.BeginPhase(EModBuildPhase::Zip);
+
+	// Written next to the old zip and swapped in at the end, a failed zip never replaces a good one
+	const FString TempZipFilePath = ZipFilePath + TEXT(".tmp");
+	FModZipWriter ZipWriter;
+	ZipWriter.SetNumThreads(Settings->ZipCompressionThreads);
+	ZipWriter.SetDeterministic(Settings->bDeterministicZips);
+	if (!ZipWriter.Open(TempZipFilePath))
 	{
-		UE_LOG(LogModdingEx, Error, TEXT("Failed to open zip file for writing: %s"), *ZipFilePath);
-		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(TEXT("Failed to open zip file for writing.")));
+		UE_LOG(LogModdingEx, Error, TEXT("Failed to open zip file for writing: %s"), *TempZipFilePath);
+		if (!IsRunningCommandlet())
+		{
+			FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(TEXT("Failed to open zip file for writing.")));
+		}
 		return false;
 	}
 
-    TUniquePtr<FZipArchiveWriter> ZipWriter = MakeUnique<FZipArchiveWriter>(ZipFileHandle.Get());
+	// Entries of the previous zip whose content didn't change are copied over compressed instead of compressing them again.
+	// A deterministic zip only reuses entries of a deterministic zip, which has a hash file, so it matches a full rezip byte for byte
+	FZipFile PreviousZip{};
+	TMap<FString, FZipEntry> PreviousEntries;
+	if (Settings->bUpdateZipsIncrementally && FileManager.FileExists(*ZipFilePath) &&
+		(!Settings->bDeterministicZips || FileManager.FileExists(*ModZipState::GetHashFilePath(ZipFilePath))))
+	{
+		FZipError ZipError{};
+		if (FZipFile::TryOpenZipFile(ZipFilePath, PreviousZip, ZipError))
+		{
+			for (FZipEntry& Entry : PreviousZip.GetEntries(ZipError))
+			{
+				if (Entry.Name)
+				{
+					const FString Name = *Entry.Name;
+					PreviousEntries.Add(Name, MoveTemp(Entry));
+				}
+			}
+		}
+		else
+		{
+			UE_LOG(LogModdingEx, Warning, TEXT("Can't read the previous zip %s (%d: %s), zipping every file again"), *ZipFilePath, ZipError.ErrorCode,
+				ZipError.Description ? **ZipError.Description : TEXT(""));
+		}
+	}
 
+	// Files are streamed through the writer, memory use doesn't grow with the size of the containers
 	bool bAllFilesAdded = true;
+	int32 NumStored = 0;
+	double DeflateSecondsSaved = 0.0;
+	int64 BytesNotSaved = 0;
+	int32 NumCopied = 0;
+	int64 BytesCopied = 0;
 	for (const FString& FullPathToFile : FilesToArchivePaths)
 	{
-		TArray<uint8> FileData;
-		if (!FFileHelper::LoadFileToArray(FileData, *FullPathToFile))
+		FString FileNameInZip = FPaths::GetCleanFilename(FullPathToFile);
+		const FModZipMethodChoice Choice = Settings->bStoreCompressedFiles ? FModZipWriter::ChooseMethod(FullPathToFile) : FModZipMethodChoice();
+		const int64 FileSize = FileManager.FileSize(*FullPathToFile);
+
+		// Size and method are checked first, the CRC takes a read of the file but that is still far cheaper than deflating it
+		const FZipEntry* PreviousEntry = PreviousEntries.Find(FileNameInZip);
+		uint32 Crc = 0;
+		if (PreviousEntry && PreviousEntry->DecompressedSize == (uint64)FileSize &&
+			PreviousEntry->CompressionMethod == (Choice.Method == EModZipMethod::Deflate ? ZIP_CM_DEFLATE : ZIP_CM_STORE) &&
+			FModZipWriter::ComputeCrc(FullPathToFile, Crc) && Crc == PreviousEntry->Crc)
 		{
-			UE_LOG(LogModdingEx, Error, TEXT("Failed to read file data for zipping: %s"), *FullPathToFile);
+			FZipError ZipError{};
+			const TOptional<FZipEntry> RawEntry = PreviousZip.GetEntryIndex(PreviousEntry->Index, ZipError, true);
+			const double CopyStartTime = FPlatformTime::Seconds();
+			if (RawEntry && ZipWriter.AddRawEntry(FileNameInZip, Choice.Method, Crc, FileSize, PreviousEntry->CompressedSize, FDateTime::Now(),
+				[&PreviousZip, &RawEntry](uint8* Buffer, int64 Num) { return PreviousZip.ReadEntry(*RawEntry, Buffer, Num); }))
+			{
+				NumCopied++;
+				BytesCopied += FileSize;
+				UE_LOG(LogModdingEx, Log, TEXT("Copied unchanged '%s' from the previous zip in %.1fs"), *FileNameInZip, FPlatformTime::Seconds() - CopyStartTime);
+				continue;
+			}
+
+			UE_LOG(LogModdingEx, Error, TEXT("Failed to copy '%s' from the previous zip: %s"), *FileNameInZip,
+				RawEntry ? *ZipWriter.GetError() : (ZipError.Description ? **ZipError.Description : TEXT("can't open the entry")));
 			bAllFilesAdded = false;
-			continue;
+			break;
 		}
 
-		FString FileNameInZip = FPaths::GetCleanFilename(FullPathToFile);
 		UE_LOG(LogModdingEx, Log, TEXT("Adding '%s' to zip archive."), *FileNameInZip);
-		ZipWriter->AddFile(FileNameInZip, FileData, FDateTime::Now());
+		const double AddStartTime = FPlatformTime::Seconds();
+		if (!ZipWriter.AddFile(FileNameInZip, FullPathToFile, Choice.Method, FDateTime::Now()))
+		{
+			UE_LOG(LogModdingEx, Error, TEXT("Failed to add '%s' to the zip: %s"), *FullPathToFile, *ZipWriter.GetError());
+			bAllFilesAdded = false;
+			break;
+		}
+
+		const double AddSeconds = FPlatformTime::Seconds() - AddStartTime;
+		if (Choice.Method == EModZipMethod::Store)
+		{
+			NumStored++;
+			DeflateSecondsSaved += Choice.EstimatedDeflateSeconds;
+			BytesNotSaved += (int64)(FileSize * (1.0 - Choice.SampleRatio));
+			UE_LOG(LogModdingEx, Log, TEXT("Stored '%s' in %.1fs, it's already compressed (samples deflate to %.1f%%), skipping deflate saves ~%.1fs of CPU for ~%.2f MB"),
+				*FileNameInZip, AddSeconds, Choice.SampleRatio * 100.0, Choice.EstimatedDeflateSeconds, FileSize * (1.0 - Choice.SampleRatio) / (1024.0 * 1024.0));
+		}
+		else
+		{
+			UE_LOG(LogModdingEx, Log, TEXT("Deflated '%s' in %.1fs to %.1f%% of %.2f MB"), *FileNameInZip, AddSeconds,
+				100.0 * ZipWriter.GetLastEntryCompressedSize() / FMath::Max<int64>(FileSize, 1), FileSize / (1024.0 * 1024.0));
+		}
+	}
+
+	if (NumStored > 0)
+	{
+		UE_LOG(LogModdingEx, Display, TEXT("Stored %d already compressed files uncompressed, saving ~%.1fs of CPU for a zip ~%.2f MB larger"),
+			NumStored, DeflateSecondsSaved, BytesNotSaved / (1024.0 * 1024.0));
+	}
+	if (NumCopied > 0)
+	{
+		UE_LOG(LogModdingEx, Display, TEXT("Copied %d unchanged files (%.2f MB) from the previous zip without compressing them again"),
+			NumCopied, BytesCopied / (1024.0 * 1024.0));
+	}
+
+	// The previous zip is replaced below, libzip must let go of it first
+	PreviousEntries.Empty();
+	PreviousZip = FZipFile{};
+
+	if (bAllFilesAdded && !ZipWriter.Close())
+	{
+		UE_LOG(LogModdingEx, Error, TEXT("Failed to finish the zip: %s"), *ZipWriter.GetError());
+		bAllFilesAdded = false;
+	}
+
+	if (bAllFilesAdded && !FileManager.Move(*ZipFilePath, *TempZipFilePath, true))
+	{
+		UE_LOG(LogModdingEx, Error, TEXT("Failed to replace %s, is it open in another program?"), *ZipFilePath);
+		FileManager.Delete(*TempZipFilePath, false, true, true);
+		bAllFilesAdded = false;
+	}
+
+	// A stale hash file would describe the old zip, it's only kept for zips that can be reproduced
+	const FString HashFilePath = ModZipState::GetHashFilePath(ZipFilePath);
+	FString ZipHash;
+	if (bAllFilesAdded && Settings->bDeterministicZips)
+	{
+		if (ModZipState::Record(ZipFilePath, InputKey, ZipHash))
+		{
+			UE_LOG(LogModdingEx, Log, TEXT("Zip SHA1 %s written to %s"), *ZipHash, *HashFilePath);
+		}
+		else
+		{
+			UE_LOG(LogModdingEx, Warning, TEXT("Failed to write the zip hash file %s"), *HashFilePath);
+		}
+	}
+	else if (bAllFilesAdded)
+	{
+		FileManager.Delete(*HashFilePath, false, true, true);
 	}
 
-    ZipWriter.Reset();
-    ZipFileHandle.Reset();
+	FModBuildRecord Record;
+	Record.Time = FDateTime::Now();
+	Record.ModName = ModName;
+	Record.Result = bAllFilesAdded ? TEXT("Zipped") : TEXT("ZipFailed");
+	Profiler.Finish(Record);
+	ModBuildHistory::Append(Record);
 
 
 	if (!bAllFilesAdded) {
-        UE_LOG(LogModdingEx, Error, TEXT("One or more files could not be read and added to the zip archive: %s"), *ZipFilePath);
-        FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(TEXT("Failed to read some files while creating the zip. Check logs.")));
+        UE_LOG(LogModdingEx, Error, TEXT("The zip archive could not be created: %s"), *ZipFilePath);
+        if (!IsRunningCommandlet())
+        {
+            FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(TEXT("Failed to create the zip. Check logs.")));
+        }
         return false;
     }
 
+	UE_LOG(LogModdingEx, Display, TEXT("Mod '%s' zipped successfully: %s"), *ModName, *ZipFilePath);
+	if (IsRunningCommandlet())
+	{
+		return true;
+	}
+
 	// --- Success Notification ---
 	FNotificationInfo Info(FText::FromString(FString::Format(TEXT("Mod '{0}' zipped successfully!"), {ModName})));
 	Info.Image = FAppStyle::GetBrush(TEXT("LevelEditor.RecompileGameCode"));
@@ -552,6 +1685,10 @@ bool UModBuilder::ZipModInternal(const FString& ModName)
 	Info.bUseThrobber = false;
 	Info.bUseSuccessFailIcons = true;
 	Info.bUseLargeFont = true;
+	if (NumStored > 0 || NumCopied > 0)
+	{
+		Info.SubText = FText::FromString(FString::Printf(TEXT("%d already compressed files stored, %d unchanged files copied"), NumStored, NumCopied));
+	}
 	Info.bFireAndForget = false;
 	Info.bAllowThrottleWhenFrameRateIsLow = false;
 	const auto NotificationItem = FSlateNotificationManager::Get().AddNotification(Info);
@@ -576,12 +1713,64 @@ bool UModBuilder::ZipMod(const FString& ModName)
 	if (Settings->bAlwaysBuildBeforeZipping)
 	{
 		UE_LOG(LogModdingEx, Log, TEXT("Building mod '%s' before zipping (using UAT)..."), *ModName);
-		if (!BuildMod(ModName))
+		const EModBuildResult Result = BuildModBlocking(ModName);
+		if (Result == EModBuildResult::Failed || Result == EModBuildResult::Cancelled)
 		{
 			UE_LOG(LogModdingEx, Error, TEXT("Failed to zip mod '%s' because the UAT build failed."), *ModName);
-		return false;
-	}
+			return false;
+		}
+		if (!ShouldRezip(ModName, Result))
+		{
+			return true;
+		}
         UE_LOG(LogModdingEx, Log, TEXT("Build successful, proceeding to zip mod '%s'..."), *ModName);
-}
+	}
 	return ZipModInternal(ModName);
-}
\ No newline at end of file
+}
+
+TFuture<bool> UModBuilder::ZipModAsync(const FString& ModName)
+{
+	const auto Settings = GetDefault<UModdingExSettings>();
+
+	if (!Settings->bAlwaysBuildBeforeZipping)
+	{
+		return MakeFulfilledPromise<bool>(ZipModInternal(ModName)).GetFuture();
+	}
+
+	UE_LOG(LogModdingEx, Log, TEXT("Building mod '%s' before zipping (using UAT)..."), *ModName);
+
+	// BuildModAsync fulfills its promise on the game thread, so zipping can safely show dialogs
+	return BuildModAsync(ModName).Next([ModName](EModBuildResult Result)
+	{
+		if (Result == EModBuildResult::Failed || Result == EModBuildResult::Cancelled)
+		{
+			UE_LOG(LogModdingEx, Error, TEXT("Failed to zip mod '%s' because the UAT build failed."), *ModName);
+			return false;
+		}
+		if (!ShouldRezip(ModName, Result))
+		{
+			return true;
+		}
+
+		UE_LOG(LogModdingEx, Log, TEXT("Build successful, proceeding to zip mod '%s'..."), *ModName);
+		return ZipModInternal(ModName);
+	});
+}
+
+bool UModBuilder::ShouldRezip(const FString& ModName, EModBuildResult BuildResult)
+{
+	if (BuildResult != EModBuildResult::ContentUnchanged || GetDefault<UModdingExSettings>()->bZipWhenContentIsSame)
+	{
+		return true;
+	}
+
+	const FString ZipFilePath = GetZipOutputDir() / (ModName + TEXT(".zip"));
+	if (!FPaths::FileExists(ZipFilePath))
+	{
+		return true;
+	}
+
+	UE_LOG(LogModdingEx, Log, TEXT("Content of '%s' is unchanged, keeping the existing zip: %s"), *ModName, *ZipFilePath);
+	Notifications::ShowSuccessNotification(FText::FromString(FString::Format(TEXT("Mod '{0}' is unchanged, kept the existing zip"), {ModName})));
+	return false;
+}
@@ -11,6 +11,9 @@
 #include "PropertyEditorModule.h"
 #include "SPositiveActionButton.h"
 #include "StartupDialog.h"
+#include "Build/ModBuildScheduler.h"
+#include "Build/SModBuildHistory.h"
+#include "Build/SModBuildQueue.h"
 #include "Widgets/Docking/SDockTab.h"
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/Text/STextBlock.h"
@@ -30,6 +33,9 @@ DEFINE_LOG_CATEGORY(LogModdingEx);
 
 #define ABSPATH(x) FPaths::ConvertRelativePathToFull(x)
 
+const FName FModdingExModule::BuildHistoryTabName = TEXT("ModdingExBuildHistory");
+const FName FModdingExModule::BuildQueueTabName = TEXT("ModdingExBuildQueue");
+
 void FModdingExModule::StartupModule()
 {
 	FModdingExStyle::Initialize();
@@ -72,6 +78,38 @@ void FModdingExModule::StartupModule()
 		FExecuteAction::CreateRaw(this, &FModdingExModule::OnOpenRepository),
 		FCanExecuteAction());
 
+	PluginCommands->MapAction(
+		FModdingExCommands::Get().OpenBuildHistory,
+		FExecuteAction::CreateRaw(this, &FModdingExModule::OnOpenBuildHistory),
+		FCanExecuteAction());
+
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(BuildHistoryTabName, FOnSpawnTab::CreateLambda([](const FSpawnTabArgs&)
+	{
+		return SNew(SDockTab)
+			.TabRole(NomadTab)
+			[
+				SNew(SModBuildHistory)
+			];
+	}))
+	.SetDisplayName(LOCTEXT("BuildHistoryTab", "Mod Build History"))
+	.SetMenuType(ETabSpawnerMenuType::Hidden);
+
+	PluginCommands->MapAction(
+		FModdingExCommands::Get().OpenBuildQueue,
+		FExecuteAction::CreateRaw(this, &FModdingExModule::OnOpenBuildQueue),
+		FCanExecuteAction());
+
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(BuildQueueTabName, FOnSpawnTab::CreateLambda([](const FSpawnTabArgs&)
+	{
+		return SNew(SDockTab)
+			.TabRole(NomadTab)
+			[
+				SNew(SModBuildQueue)
+			];
+	}))
+	.SetDisplayName(LOCTEXT("BuildQueueTab", "Mod Build Queue"))
+	.SetMenuType(ETabSpawnerMenuType::Hidden);
+
 	Thunderstore.RegisterSections(Sections, PluginCommands);
 
 	OnModManagerChanged.BindRaw(this, &FModdingExModule::RegisterMenus);
@@ -97,6 +135,9 @@ void FModdingExModule::ShutdownModule()
 
 	FModdingExCommands::Unregister();
 
+	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(BuildHistoryTabName);
+	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(BuildQueueTabName);
+
 	if (ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings"))
 	{
 		SettingsModule->UnregisterSettings("Project", "Plugins", "ModdingEx");
@@ -109,6 +150,9 @@ void FModdingExModule::ShutdownModule()
 	}
 	
 	FWorldDelegates::OnPostWorldInitialization.RemoveAll(this);
+
+	ModWatcher.Shutdown();
+	FModBuildScheduler::Get().Shutdown();
 }
 
 void FModdingExModule::RegisterMenus()
@@ -140,13 +184,63 @@ void FModdingExModule::RegisterMenus()
 								FSlateIcon(),
 								FUIAction(FExecuteAction::CreateLambda([this, Mod]
 								{
-									UModBuilder::BuildMod(Mod);
+									UModBuilder::BuildModAsync(Mod);
+								}))
+							);
+						}
+
+						if (Mods.Num() > 1)
+						{
+							MenuBuilder.AddMenuEntry(
+								LOCTEXT("ModdingEx_BuildAllMods", "All Mods"),
+								LOCTEXT("ModdingEx_BuildAllModsTooltip", "Cook all mods at once and create one pak per mod"),
+								FSlateIcon(),
+								FUIAction(FExecuteAction::CreateLambda([Mods]
+								{
+									UModBuilder::BuildModsAsync(Mods);
+								}))
+							);
+
+							MenuBuilder.AddMenuEntry(
+								LOCTEXT("ModdingEx_BuildAllModsParallel", "All Mods Side By Side"),
+								LOCTEXT("ModdingEx_BuildAllModsParallelTooltip", "Queue all mods and cook several of them at once, each in its own UAT run and staging dir"),
+								FSlateIcon(),
+								FUIAction(FExecuteAction::CreateLambda([this, Mods]
+								{
+									FModBuildScheduler::Get().Enqueue(Mods);
+									OnOpenBuildQueue();
 								}))
 							);
 						}
 
 						MenuBuilder.EndSection();
 
+						MenuBuilder.BeginSection("ModdingEx_WatchModsEntry", LOCTEXT("ModdingEx_WatchMod", "Watch Mod"));
+
+						for (FString Mod : Mods)
+						{
+							MenuBuilder.AddMenuEntry(
+								FText::FromString(Mod),
+								FText::FromString(FString::Format(TEXT("Rebuild and deploy {0} in the background whenever its assets are saved"), {Mod})),
+								FSlateIcon(),
+								FUIAction(
+									FExecuteAction::CreateLambda([this, Mod]
+									{
+										ModWatcher.SetWatching(Mod, !ModWatcher.IsWatching(Mod));
+									}),
+									FCanExecuteAction(),
+									FIsActionChecked::CreateLambda([this, Mod]
+									{
+										return ModWatcher.IsWatching(Mod);
+									})
+								),
+								NAME_None,
+								EUserInterfaceActionType::ToggleButton
+							);
+						}
+
+						MenuBuilder.EndSection();
+
 						const auto Settings = GetDefault<UModdingExSettings>();
 						if (Settings->bUsingThunderstore)
 						{
@@ -178,7 +272,7 @@ void FModdingExModule::RegisterMenus()
 								FSlateIcon(),
 								FUIAction(FExecuteAction::CreateLambda([this, Mod]
 								{
-									UModBuilder::ZipMod(Mod);
+									UModBuilder::ZipModAsync(Mod);
 								}))
 							);
 						}
@@ -231,6 +325,8 @@ void FModdingExModule::RegisterMenus()
 						MenuBuilder.AddMenuEntry(FModdingExCommands::Get().OpenBlueprintCreator);
 						MenuBuilder.AddMenuEntry(FModdingExCommands::Get().OpenGameFolder);
 						MenuBuilder.AddMenuEntry(FModdingExCommands::Get().OpenPluginSettings);
+						MenuBuilder.AddMenuEntry(FModdingExCommands::Get().OpenBuildHistory);
+						MenuBuilder.AddMenuEntry(FModdingExCommands::Get().OpenBuildQueue);
 
 						for (const auto& Section : Sections)
 						{
@@ -803,11 +899,26 @@ FReply FModdingExModule::TryStartGame() const
 		if(!Mod.IsEmpty() && Mod != "None")
 		{
 			UE_LOG(LogModdingEx, Log, TEXT("Starting game after building %s"), *Mod);
-			if(!UModBuilder::BuildMod(Mod, !Settings->bDontCheckHashOnGameStart) && !Settings->bShouldStartGameAfterFailedBuild)
+
+			// The build runs in the background, the game is started once it finished
+			// An unchanged mod is not deployed again, the game can start right away
+			UModBuilder::BuildModAsync(Mod, !Settings->bDontCheckHashOnGameStart).Next([Mod, GamePath, Params](EModBuildResult Result)
 			{
-				UE_LOG(LogModdingEx, Error, TEXT("Failed to build mod %s"), *Mod);
-				return FReply::Handled();
-			}
+				if (Result == EModBuildResult::Cancelled)
+				{
+					return;
+				}
+
+				if(Result == EModBuildResult::Failed && !GetDefault<UModdingExSettings>()->bShouldStartGameAfterFailedBuild)
+				{
+					UE_LOG(LogModdingEx, Error, TEXT("Failed to build mod %s"), *Mod);
+					return;
+				}
+
+				FPlatformProcess::CreateProc(*GamePath, *Params, true, false, false, nullptr, 0, nullptr, nullptr);
+			});
+
+			return FReply::Handled();
 		}
 	}
 	
@@ -837,6 +948,16 @@ void FModdingExModule::OnOpenPluginSettings() const
 	FModuleManager::LoadModuleChecked<ISettingsModule>("Settings").ShowViewer("Project", "Plugins", "ModdingEx");
 }
 
+void FModdingExModule::OnOpenBuildHistory() const
+{
+	FGlobalTabmanager::Get()->TryInvokeTab(BuildHistoryTabName);
+}
+
+void FModdingExModule::OnOpenBuildQueue() const
+{
+	FGlobalTabmanager::Get()->TryInvokeTab(BuildQueueTabName);
+}
+
 void FModdingExModule::OnOpenRepository() const
 {
 	FPlatformProcess::LaunchURL(TEXT("https://github.com/ToniMacaroni/ModdingEx"), nullptr, nullptr);
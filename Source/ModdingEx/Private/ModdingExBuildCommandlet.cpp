@@ -0,0 +1,208 @@
+#include "ModdingExBuildCommandlet.h"
+
+#include "ModBuilder.h"
+#include "ModdingAssets.h"
+#include "ModdingEx.h"
+#include "ModdingExSettings.h"
+#include "Algo/AllOf.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Build/ModBuildContext.h"
+#include "Build/ModBuildReport.h"
+#include "Build/ModBuildScheduler.h"
+#include "Build/ModDeploy.h"
+#include "Containers/Ticker.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/Paths.h"
+
+UModdingExBuildCommandlet::UModdingExBuildCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+
+	HelpDescription = TEXT("Builds, zips and stages mods without the editor UI");
+	HelpUsage = TEXT("-run=ModdingExBuild [-Mods=A+B] [-Zip] [-StageDir=<Dir>] [-Parallel=<N>] [-Report=<File>] [-OutputDir=<Dir>] [-ZipDir=<Dir>] [-Platform=<Platform>] [-Force]");
+}
+
+int32 UModdingExBuildCommandlet::Main(const FString& Params)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	UModdingExSettings* Settings = GetMutableDefault<UModdingExSettings>();
+
+	TArray<FString> ModNames;
+	FString ModsParam;
+	if (FParse::Value(*Params, TEXT("Mods="), ModsParam))
+	{
+		ModsParam.ParseIntoArray(ModNames, TEXT("+"));
+	}
+	else
+	{
+		ModdingAssets::GetMods(ModNames);
+	}
+
+	if (ModNames.IsEmpty())
+	{
+		UE_LOG(LogModdingEx, Error, TEXT("No mods to build, pass -Mods=A+B or create a mod with a ModActor first"));
+		return 1;
+	}
+
+	for (const FString& ModName : ModNames)
+	{
+		if (!ModdingAssets::DoesModExist(ModName))
+		{
+			UE_LOG(LogModdingEx, Error, TEXT("Mod '%s' doesn't exist or has no ModActor"), *ModName);
+			return 1;
+		}
+	}
+
+	// Overrides only live for this run, the settings are never saved
+	FString OutputDir;
+	if (FParse::Value(*Params, TEXT("OutputDir="), OutputDir))
+	{
+		Settings->CustomPakDir.Path = FPaths::ConvertRelativePathToFull(OutputDir);
+	}
+
+	FString ZipDir;
+	if (FParse::Value(*Params, TEXT("ZipDir="), ZipDir))
+	{
+		Settings->ModZipDir.Path = FPaths::ConvertRelativePathToFull(ZipDir);
+	}
+
+	FString StageDir;
+	if (FParse::Value(*Params, TEXT("StageDir="), StageDir))
+	{
+		StageDir = FPaths::ConvertRelativePathToFull(StageDir);
+	}
+
+	FString Platform = TEXT("Win64");
+	FParse::Value(*Params, TEXT("Platform="), Platform);
+
+	FString ReportPath = FPaths::ProjectSavedDir() / TEXT("ModdingEx") / TEXT("BuildReport.json");
+	FParse::Value(*Params, TEXT("Report="), ReportPath);
+
+	const bool bZip = FParse::Param(*Params, TEXT("Zip"));
+	const bool bForce = FParse::Param(*Params, TEXT("Force"));
+
+	// Without -Parallel the scheduler picks as many builds as the cores and memory allow
+	int32 Parallelism = 0;
+	FParse::Value(*Params, TEXT("Parallel="), Parallelism);
+	FModBuildScheduler& Scheduler = FModBuildScheduler::Get();
+	Scheduler.SetMaxConcurrencyOverride(FMath::Max(0, Parallelism));
+	Scheduler.SetPlatformName(Platform);
+
+	// Commandlets don't scan in the background, the cook set and package membership need the full registry
+	FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get().SearchAllAssets(true);
+
+	FModBuildReport Report;
+	Report.Time = FDateTime::UtcNow().ToIso8601();
+	Report.EngineVersion = FEngineVersion::Current().ToString();
+	Report.Platform = Platform;
+	Report.Parallelism = Scheduler.GetMaxConcurrency();
+
+	const FDelegateHandle OnBuildFinishedHandle = Scheduler.OnBuildFinished.AddLambda([&Report, bZip, &StageDir](const FModBuildQueueItem& Item)
+	{
+		Report.Mods.Add(FinishModBuild(*Item.Context, Item.Result, bZip, StageDir));
+	});
+	Scheduler.Enqueue(ModNames, bForce);
+
+	// Builds hand their results back through game thread tasks, the scheduler and the progress run on the core ticker
+	double LastTickTime = FPlatformTime::Seconds();
+	while (!Scheduler.IsIdle())
+	{
+		const double Now = FPlatformTime::Seconds();
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		FTSTicker::GetCoreTicker().Tick(Now - LastTickTime);
+		LastTickTime = Now;
+
+		FPlatformProcess::Sleep(0.05f);
+	}
+
+	Scheduler.OnBuildFinished.Remove(OnBuildFinishedHandle);
+
+	Report.Mods.Sort([](const FModBuildReportMod& A, const FModBuildReportMod& B) { return A.ModName < B.ModName; });
+	Report.TotalSeconds = FPlatformTime::Seconds() - StartTime;
+	Report.bSucceeded = Algo::AllOf(Report.Mods, [](const FModBuildReportMod& Mod) { return Mod.Error.IsEmpty(); });
+
+	for (const FModBuildReportMod& Mod : Report.Mods)
+	{
+		UE_LOG(LogModdingEx, Display, TEXT("%-32s %-16s %8.1fs %3d warnings"), *Mod.ModName, *Mod.Result, Mod.TotalSeconds, Mod.Warnings.Num());
+	}
+
+	if (ModBuildReport::Save(ReportPath, Report))
+	{
+		UE_LOG(LogModdingEx, Display, TEXT("Build report written to %s"), *ReportPath);
+	}
+
+	return Report.bSucceeded ? 0 : 1;
+}
+
+FModBuildReportMod UModdingExBuildCommandlet::FinishModBuild(const FModBuildContext& Context, EModBuildResult Result, bool bZip, const FString& StageDir)
+{
+	const FString& ModName = Context.ModName;
+
+	FModBuildReportMod ModReport;
+	ModReport.ModName = ModName;
+	ModReport.Result = StaticEnum<EModBuildResult>()->GetNameStringByValue((int64)Result);
+	ModReport.TotalSeconds = Context.Record.TotalSeconds;
+	ModReport.Warnings = Context.Warnings;
+
+	for (int32 Phase = 0; Phase < (int32)EModBuildPhase::Num; Phase++)
+	{
+		if (Context.Record.PhaseSeconds[Phase] > 0.0)
+		{
+			ModReport.PhaseSeconds.Add(LexToString((EModBuildPhase)Phase), Context.Record.PhaseSeconds[Phase]);
+		}
+	}
+
+	if (Result == EModBuildResult::Failed || Result == EModBuildResult::Cancelled)
+	{
+		ModReport.Error = Context.ErrorMessage.IsEmpty() ? TEXT("Build failed, check the log") : Context.ErrorMessage;
+		return ModReport;
+	}
+
+	TArray<FString> StageFiles;
+	for (const TCHAR* Extension : { TEXT(".pak"), TEXT(".utoc"), TEXT(".ucas") })
+	{
+		FModBuildReportFile Output;
+		if (ModBuildReport::DescribeFile(Context.FinalDestinationDir / (ModName + Extension), Output))
+		{
+			StageFiles.Add(Output.Path);
+			ModReport.Outputs.Add(MoveTemp(Output));
+		}
+	}
+
+	if (bZip)
+	{
+		const double ZipStartTime = FPlatformTime::Seconds();
+		if (!UModBuilder::ZipModInternal(ModName))
+		{
+			ModReport.Result = TEXT("ZipFailed");
+			ModReport.Error = TEXT("Zipping failed, check the log");
+			return ModReport;
+		}
+
+		ModReport.PhaseSeconds.Add(LexToString(EModBuildPhase::Zip), FPlatformTime::Seconds() - ZipStartTime);
+		ModBuildReport::DescribeFile(UModBuilder::GetZipOutputDir() / (ModName + TEXT(".zip")), ModReport.Zip);
+		StageFiles.Add(ModReport.Zip.Path);
+	}
+
+	if (!StageDir.IsEmpty())
+	{
+		for (const FString& File : StageFiles)
+		{
+			EModDeployMethod Method;
+			if (!ModDeploy::DeployFile(File, StageDir / ModName / FPaths::GetCleanFilename(File), true, Method))
+			{
+				UE_LOG(LogModdingEx, Error, TEXT("Failed to stage '%s' to %s"), *File, *(StageDir / ModName));
+				ModReport.Result = TEXT("StageFailed");
+				ModReport.Error = FString::Printf(TEXT("Failed to stage '%s'"), *File);
+				return ModReport;
+			}
+		}
+	}
+
+	return ModReport;
+}
@@ -14,6 +14,10 @@ void FModdingExCommands::RegisterCommands()
 	           FInputChord());
 	UI_COMMAND(OpenRepository, "Open Repository", "Open the ModdingEx repository", EUserInterfaceActionType::Button,
 	           FInputChord());
+	UI_COMMAND(OpenBuildHistory, "Build History", "Show how long past mod builds took per phase", EUserInterfaceActionType::Button,
+	           FInputChord());
+	UI_COMMAND(OpenBuildQueue, "Build Queue", "Show the mods queued for building side by side and their state", EUserInterfaceActionType::Button,
+	           FInputChord());
 }
 
 #undef LOCTEXT_NAMESPACE
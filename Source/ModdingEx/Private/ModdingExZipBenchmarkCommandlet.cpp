@@ -0,0 +1,140 @@
+#include "ModdingExZipBenchmarkCommandlet.h"
+
+#include "ModdingEx.h"
+#include "FileUtilities/ZipArchiveWriter.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Zip/ModZipWriter.h"
+
+UModdingExZipBenchmarkCommandlet::UModdingExZipBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Compares the engine zip writer with the streaming and the multi-threaded mod zip writer");
+	HelpUsage = TEXT("-run=ModdingExZipBenchmark -Files=A.ucas+B.pak [-Threads=<N>] [-Runs=<N>]");
+}
+
+int32 UModdingExZipBenchmarkCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Files;
+	FString FilesParam;
+	if (FParse::Value(*Params, TEXT("Files="), FilesParam))
+	{
+		FilesParam.ParseIntoArray(Files, TEXT("+"));
+	}
+
+	if (Files.IsEmpty())
+	{
+		UE_LOG(LogModdingEx, Error, TEXT("No files to zip, pass -Files=A.ucas+B.pak"));
+		return 1;
+	}
+
+	int64 TotalBytes = 0;
+	for (FString& File : Files)
+	{
+		File = FPaths::ConvertRelativePathToFull(File);
+		const int64 Size = IFileManager::Get().FileSize(*File);
+		if (Size < 0)
+		{
+			UE_LOG(LogModdingEx, Error, TEXT("File doesn't exist: %s"), *File);
+			return 1;
+		}
+		TotalBytes += Size;
+	}
+
+	int32 Threads = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+	FParse::Value(*Params, TEXT("Threads="), Threads);
+	Threads = FMath::Max(2, Threads);
+
+	int32 Runs = 1;
+	FParse::Value(*Params, TEXT("Runs="), Runs);
+	Runs = FMath::Max(1, Runs);
+
+	const FString ZipPath = FPaths::ProjectSavedDir() / TEXT("ModdingEx") / TEXT("ZipBenchmark.zip");
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(ZipPath), true);
+
+	// The engine writer takes each file as one buffer, which is how mods were zipped before the streaming writer
+	auto ZipWithEngineWriter = [&Files, &ZipPath]
+	{
+		const TUniquePtr<IFileHandle> ZipFile(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*ZipPath));
+		if (!ZipFile)
+		{
+			return false;
+		}
+
+		FZipArchiveWriter Writer(ZipFile.Get());
+		for (const FString& File : Files)
+		{
+			TArray<uint8> Data;
+			if (!FFileHelper::LoadFileToArray(Data, *File))
+			{
+				return false;
+			}
+			Writer.AddFile(FPaths::GetCleanFilename(File), Data, FDateTime::Now());
+		}
+		return true;
+	};
+
+	auto ZipWithModWriter = [&Files, &ZipPath](int32 NumThreads, bool bChooseMethod)
+	{
+		FModZipWriter Writer;
+		Writer.SetNumThreads(NumThreads);
+		if (!Writer.Open(ZipPath))
+		{
+			return false;
+		}
+
+		for (const FString& File : Files)
+		{
+			const EModZipMethod Method = bChooseMethod ? FModZipWriter::ChooseMethod(File).Method : EModZipMethod::Deflate;
+			if (!Writer.AddFile(FPaths::GetCleanFilename(File), File, Method, FDateTime::Now()))
+			{
+				UE_LOG(LogModdingEx, Error, TEXT("%s"), *Writer.GetError());
+				return false;
+			}
+		}
+		return Writer.Close();
+	};
+
+	struct FBenchmark
+	{
+		FString Name;
+		TFunction<bool()> Run;
+	};
+
+	const TArray<FBenchmark> Benchmarks = {
+		{ TEXT("FZipArchiveWriter"), ZipWithEngineWriter },
+		{ TEXT("FModZipWriter, 1 thread"), [&ZipWithModWriter] { return ZipWithModWriter(1, false); } },
+		{ FString::Printf(TEXT("FModZipWriter, %d threads"), Threads), [&ZipWithModWriter, Threads] { return ZipWithModWriter(Threads, false); } },
+		{ FString::Printf(TEXT("FModZipWriter, %d threads, sampled"), Threads), [&ZipWithModWriter, Threads] { return ZipWithModWriter(Threads, true); } },
+	};
+
+	UE_LOG(LogModdingEx, Display, TEXT("Zipping %d files, %.1f MB, best of %d runs"), Files.Num(), TotalBytes / (1024.0 * 1024.0), Runs);
+
+	for (const FBenchmark& Benchmark : Benchmarks)
+	{
+		double BestSeconds = TNumericLimits<double>::Max();
+		for (int32 Run = 0; Run < Runs; Run++)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			if (!Benchmark.Run())
+			{
+				UE_LOG(LogModdingEx, Error, TEXT("%s failed to write %s"), *Benchmark.Name, *ZipPath);
+				return 1;
+			}
+			BestSeconds = FMath::Min(BestSeconds, FPlatformTime::Seconds() - StartTime);
+		}
+
+		const int64 ZipSize = IFileManager::Get().FileSize(*ZipPath);
+		UE_LOG(LogModdingEx, Display, TEXT("%-32s %8.2fs %8.1f MB/s %10.1f MB zip (%.1f%%)"), *Benchmark.Name, BestSeconds,
+			TotalBytes / (1024.0 * 1024.0) / FMath::Max(BestSeconds, 0.001), ZipSize / (1024.0 * 1024.0), 100.0 * ZipSize / FMath::Max<int64>(TotalBytes, 1));
+	}
+
+	IFileManager::Get().Delete(*ZipPath, false, true, true);
+	return 0;
+}
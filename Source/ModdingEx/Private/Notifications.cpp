@@ -1,5 +1,6 @@
 ﻿#include "Notifications.h"
 
+#include "ModdingEx.h"
 #include "Widgets/Notifications/SNotificationList.h"
 #include "Framework/Notifications/NotificationManager.h"
 
@@ -9,6 +10,12 @@ namespace Notifications
 {
 	void ShowFailNotification(const FText& Text, bool bShowOutputLog)
 	{
+		if (IsRunningCommandlet())
+		{
+			UE_LOG(LogModdingEx, Error, TEXT("%s"), *Text.ToString());
+			return;
+		}
+
 		FNotificationInfo Info(Text);
 		Info.ExpireDuration = 5.0f;
 		Info.bFireAndForget = true;
@@ -28,6 +35,12 @@ namespace Notifications
 
 	void ShowSuccessNotification(const FText& Text)
 	{
+		if (IsRunningCommandlet())
+		{
+			UE_LOG(LogModdingEx, Display, TEXT("%s"), *Text.ToString());
+			return;
+		}
+
 		FNotificationInfo Info(Text);
 		Info.ExpireDuration = 2.5f;
 		Info.bFireAndForget = true;
@@ -0,0 +1,95 @@
+#include "Zip/ModZipState.h"
+
+#include "Build/ModHash.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+
+namespace ModZipState
+{
+	// Bump when the writer changes the bytes it produces for the same input, so zips made by an older version aren't kept
+	constexpr int32 FormatVersion = 1;
+
+	// Kept out of the zip dir, only the hash file there is meant to be shipped
+	FString GetInputsFilePath(const FString& ZipPath)
+	{
+		return FPaths::ProjectIntermediateDir() / TEXT("ModdingEx") / TEXT("ZipInputs") / (FPaths::GetCleanFilename(ZipPath) + TEXT(".txt"));
+	}
+
+	FString GetHashFilePath(const FString& ZipPath)
+	{
+		return ZipPath + TEXT(".sha1");
+	}
+
+	FString ComputeInputKey(const TArray<FString>& FilePaths, bool bStoreCompressedFiles)
+	{
+		FSHA1 Sha;
+		auto AddString = [&Sha](const FString& Value)
+		{
+			Sha.UpdateWithString(*Value, Value.Len() + 1);
+		};
+
+		AddString(FString::FromInt(FormatVersion));
+		AddString(bStoreCompressedFiles ? TEXT("StoreCompressed") : TEXT("DeflateAll"));
+
+		for (const FString& FilePath : FilePaths)
+		{
+			FSHAHash FileHash;
+			if (!ModHash::HashFile(FilePath, FileHash))
+			{
+				return FString();
+			}
+
+			AddString(FPaths::GetCleanFilename(FilePath));
+			AddString(FileHash.ToString());
+		}
+
+		Sha.Final();
+		FSHAHash Hash;
+		Sha.GetHash(Hash.Hash);
+		return Hash.ToString();
+	}
+
+	bool IsUpToDate(const FString& ZipPath, const FString& InputKey)
+	{
+		FString Inputs;
+		FString HashFile;
+		if (InputKey.IsEmpty() || !IFileManager::Get().FileExists(*ZipPath) ||
+			!FFileHelper::LoadFileToString(Inputs, *GetInputsFilePath(ZipPath)) || !FFileHelper::LoadFileToString(HashFile, *GetHashFilePath(ZipPath)))
+		{
+			return false;
+		}
+
+		// "<input key> <zip hash>", the zip hash must still be the one in the hash file or the zip was replaced since
+		FString RecordedKey;
+		FString RecordedZipHash;
+		return Inputs.TrimStartAndEnd().Split(TEXT(" "), &RecordedKey, &RecordedZipHash) && RecordedKey == InputKey &&
+			HashFile.StartsWith(RecordedZipHash + TEXT(" "));
+	}
+
+	bool Record(const FString& ZipPath, const FString& InputKey, FString& OutZipHash)
+	{
+		FSHAHash ZipHash;
+		if (!ModHash::HashFile(ZipPath, ZipHash))
+		{
+			return false;
+		}
+
+		OutZipHash = ZipHash.ToString().ToLower();
+		const FString HashFile = FString::Printf(TEXT("%s  %s\n"), *OutZipHash, *FPaths::GetCleanFilename(ZipPath));
+		if (!FFileHelper::SaveStringToFile(HashFile, *GetHashFilePath(ZipPath)))
+		{
+			return false;
+		}
+
+		// Without a key the zip can't be matched to its inputs later, an old record would wrongly skip the next zip
+		const FString InputsFilePath = GetInputsFilePath(ZipPath);
+		if (InputKey.IsEmpty())
+		{
+			IFileManager::Get().Delete(*InputsFilePath, false, true, true);
+			return true;
+		}
+		return FFileHelper::SaveStringToFile(InputKey + TEXT(" ") + OutZipHash, *InputsFilePath);
+	}
+}
@@ -0,0 +1,594 @@
+#include "Zip/ModZipWriter.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "zlib.h"
+
+namespace ModZipWriter
+{
+	constexpr uint32 LocalHeaderSignature = 0x04034b50;
+	constexpr uint32 CentralHeaderSignature = 0x02014b50;
+	constexpr uint32 EndOfCentralDirSignature = 0x06054b50;
+	constexpr uint32 Zip64EndOfCentralDirSignature = 0x06064b50;
+	constexpr uint32 Zip64LocatorSignature = 0x07064b50;
+	constexpr uint16 Zip64ExtraId = 0x0001;
+
+	constexpr uint16 Version = 20;
+	constexpr uint16 Zip64Version = 45;
+	constexpr uint16 Utf8NameFlag = 1 << 11;
+
+	constexpr uint16 MethodStore = 0;
+	constexpr uint16 MethodDeflate = 8;
+
+	// Deflate may grow incompressible data a little, entries this close to 4 GB get Zip64 sizes up front
+	constexpr uint64 Zip64Threshold = 0xFFFFFFFFull - 0x1000000ull;
+
+	// Offset of the CRC in the local header, the sizes follow it
+	constexpr int64 LocalHeaderCrcOffset = 14;
+	constexpr int64 LocalHeaderSize = 30;
+
+	/** Little endian record builder */
+	struct FRecord
+	{
+		TArray<uint8> Bytes;
+
+		FRecord& U16(uint16 Value) { return Append(&Value, 2); }
+		FRecord& U32(uint32 Value) { return Append(&Value, 4); }
+		FRecord& U64(uint64 Value) { return Append(&Value, 8); }
+		FRecord& Append(const TArray<uint8>& Value) { Bytes.Append(Value); return *this; }
+
+	private:
+		FRecord& Append(const void* Value, int32 Num)
+		{
+			static_assert(PLATFORM_LITTLE_ENDIAN, "Zip records are little endian");
+			Bytes.Append((const uint8*)Value, Num);
+			return *this;
+		}
+	};
+
+	uint32 ToDosTime(const FDateTime& Timestamp)
+	{
+		// Dos times start in 1980 and have a 2 second resolution
+		const int32 Year = FMath::Clamp(Timestamp.GetYear(), 1980, 2107);
+		return (uint32)((Year - 1980) << 25 | Timestamp.GetMonth() << 21 | Timestamp.GetDay() << 16 |
+			Timestamp.GetHour() << 11 | Timestamp.GetMinute() << 5 | Timestamp.GetSecond() / 2);
+	}
+
+	// 1980-01-01 00:00, the earliest time a zip can hold
+	constexpr uint32 DeterministicDosTime = 1 << 21 | 1 << 16;
+
+	uint32 Clamp32(uint64 Value)
+	{
+		return Value >= 0xFFFFFFFFull ? 0xFFFFFFFFu : (uint32)Value;
+	}
+
+	// Spread over the file so a compressed container with an uncompressed index or header isn't judged by either alone
+	constexpr int32 SampleCount = 8;
+	constexpr int64 SampleSize = 64 * 1024;
+
+	// Files that deflate to more than this are stored, the few percent aren't worth the time
+	constexpr double StoreRatio = 0.95;
+
+	const TCHAR* TextExtensions[] = { TEXT("json"), TEXT("txt"), TEXT("md"), TEXT("ini"), TEXT("lua"), TEXT("cfg"), TEXT("xml"), TEXT("csv") };
+
+	// Deflate's back references reach at most this far, a block only needs this much of the data before it
+	constexpr int64 DictionaryWindow = 32 * 1024;
+
+	/**
+	 * Deflate a block on its own so blocks can be compressed in any order, like pigz does.
+	 * Blocks before the last end with a sync flush, which byte-aligns them without ending the stream, so they can be written back to back.
+	 */
+	bool DeflateBlock(const TArray<uint8>& In, const uint8* Dictionary, int64 DictionarySize, bool bFinal, TArray<uint8>& Out)
+	{
+		z_stream Stream = {};
+		if (deflateInit2(&Stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		{
+			return false;
+		}
+		ON_SCOPE_EXIT
+		{
+			deflateEnd(&Stream);
+		};
+
+		if (DictionarySize > 0 && deflateSetDictionary(&Stream, Dictionary, (uInt)DictionarySize) != Z_OK)
+		{
+			return false;
+		}
+
+		// Room for the whole block plus the flush marker, so a single call compresses it
+		Out.SetNumUninitialized(deflateBound(&Stream, In.Num()) + 16);
+		Stream.next_in = const_cast<uint8*>(In.GetData());
+		Stream.avail_in = (uInt)In.Num();
+		Stream.next_out = Out.GetData();
+		Stream.avail_out = (uInt)Out.Num();
+
+		const int32 Result = deflate(&Stream, bFinal ? Z_FINISH : Z_SYNC_FLUSH);
+		if ((bFinal && Result != Z_STREAM_END) || (!bFinal && Result != Z_OK) || Stream.avail_in != 0)
+		{
+			return false;
+		}
+
+		Out.SetNum(Out.Num() - Stream.avail_out);
+		return true;
+	}
+}
+
+FModZipMethodChoice FModZipWriter::ChooseMethod(const FString& FilePath)
+{
+	using namespace ModZipWriter;
+
+	FModZipMethodChoice Choice;
+
+	const FString Extension = FPaths::GetExtension(FilePath);
+	for (const TCHAR* TextExtension : TextExtensions)
+	{
+		if (Extension == TextExtension)
+		{
+			return Choice;
+		}
+	}
+
+	const TUniquePtr<IFileHandle> Source(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+	const int64 Size = Source ? Source->Size() : 0;
+	if (Size < SampleSize * SampleCount)
+	{
+		return Choice;
+	}
+
+	TArray<uint8> Sample;
+	Sample.SetNumUninitialized(SampleSize);
+	TArray<uint8> Compressed;
+
+	int64 CompressedBytes = 0;
+	double DeflateSeconds = 0.0;
+	for (int32 Index = 0; Index < SampleCount; Index++)
+	{
+		if (!Source->Seek((Size - SampleSize) * Index / (SampleCount - 1)) || !Source->Read(Sample.GetData(), SampleSize))
+		{
+			return Choice;
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		if (!DeflateBlock(Sample, nullptr, 0, true, Compressed))
+		{
+			return Choice;
+		}
+		DeflateSeconds += FPlatformTime::Seconds() - StartTime;
+		CompressedBytes += Compressed.Num();
+	}
+
+	const int64 SampledBytes = SampleSize * SampleCount;
+	Choice.SampleRatio = (double)CompressedBytes / SampledBytes;
+	Choice.EstimatedDeflateSeconds = DeflateSeconds * Size / SampledBytes;
+	Choice.Method = Choice.SampleRatio > StoreRatio ? EModZipMethod::Store : EModZipMethod::Deflate;
+	return Choice;
+}
+
+bool FModZipWriter::ComputeCrc(const FString& FilePath, uint32& OutCrc)
+{
+	const TUniquePtr<IFileHandle> Source(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+	if (!Source)
+	{
+		return false;
+	}
+
+	TArray<uint8> Buffer;
+	Buffer.SetNumUninitialized(BlockSize);
+
+	uint32 Crc = crc32(0, nullptr, 0);
+	for (int64 Remaining = Source->Size(); Remaining > 0;)
+	{
+		const int64 ChunkSize = FMath::Min(Remaining, BlockSize);
+		if (!Source->Read(Buffer.GetData(), ChunkSize))
+		{
+			return false;
+		}
+		Crc = crc32(Crc, Buffer.GetData(), ChunkSize);
+		Remaining -= ChunkSize;
+	}
+
+	OutCrc = Crc;
+	return true;
+}
+
+FModZipWriter::~FModZipWriter()
+{
+	// Closed without Close, the zip has no central directory and is useless
+	if (Handle)
+	{
+		Handle.Reset();
+		FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*ZipPath);
+	}
+}
+
+bool FModZipWriter::Open(const FString& InZipPath)
+{
+	ZipPath = InZipPath;
+	Entries.Empty();
+
+	Handle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*ZipPath));
+	if (!Handle)
+	{
+		Error = FString::Printf(TEXT("Failed to open '%s' for writing"), *ZipPath);
+		return false;
+	}
+	return true;
+}
+
+bool FModZipWriter::AddFile(const FString& NameInZip, const FString& SourcePath, EModZipMethod Method, const FDateTime& Timestamp)
+{
+	const TUniquePtr<IFileHandle> Source(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*SourcePath));
+	if (!Source)
+	{
+		Error = FString::Printf(TEXT("Failed to open '%s' for reading"), *SourcePath);
+		return false;
+	}
+
+	return AddEntry(NameInZip, Source->Size(), Method, Timestamp, [this, &Source, &SourcePath](uint8* Buffer, int64 Num)
+	{
+		if (!Source->Read(Buffer, Num))
+		{
+			Error = FString::Printf(TEXT("Failed to read '%s'"), *SourcePath);
+			return false;
+		}
+		return true;
+	});
+}
+
+bool FModZipWriter::AddData(const FString& NameInZip, TConstArrayView<uint8> Data, EModZipMethod Method, const FDateTime& Timestamp)
+{
+	int64 ReadOffset = 0;
+	return AddEntry(NameInZip, Data.Num(), Method, Timestamp, [&Data, &ReadOffset](uint8* Buffer, int64 Num)
+	{
+		FMemory::Memcpy(Buffer, Data.GetData() + ReadOffset, Num);
+		ReadOffset += Num;
+		return true;
+	});
+}
+
+bool FModZipWriter::AddEntry(const FString& NameInZip, int64 Size, EModZipMethod Method, const FDateTime& Timestamp, TFunctionRef<bool(uint8* Buffer, int64 Num)> Read)
+{
+	FEntry Entry;
+	if (!BeginEntry(NameInZip, Size, Method, Timestamp, Entry))
+	{
+		return false;
+	}
+
+	const int64 DataStart = Handle->Tell();
+
+	const bool bDeflate = Entry.Method == ModZipWriter::MethodDeflate;
+	const int32 ThreadCount = GetNumThreads();
+	// The block-wise stream differs from a single stream, deterministic zips use it even on one thread
+	const bool bWritten = bDeflate && (ThreadCount > 1 || bDeterministic) && Size > BlockSize
+		? WriteDeflatedParallel(Entry, Size, ThreadCount, Read)
+		: WriteData(Entry, Size, Read);
+	if (!bWritten)
+	{
+		if (Error.IsEmpty())
+		{
+			Error = FString::Printf(TEXT("Failed to compress '%s'"), *NameInZip);
+		}
+		return false;
+	}
+
+	return FinishEntry(MoveTemp(Entry), DataStart, NameInZip);
+}
+
+bool FModZipWriter::AddRawEntry(const FString& NameInZip, EModZipMethod Method, uint32 Crc, int64 UncompressedSize, int64 CompressedSize,
+	const FDateTime& Timestamp, TFunctionRef<bool(uint8* Buffer, int64 Num)> Read)
+{
+	FEntry Entry;
+	if (!BeginEntry(NameInZip, UncompressedSize, Method, Timestamp, Entry))
+	{
+		return false;
+	}
+
+	const int64 DataStart = Handle->Tell();
+
+	TArray<uint8> Buffer;
+	Buffer.SetNumUninitialized(FMath::Min(CompressedSize, BlockSize));
+	for (int64 Remaining = CompressedSize; Remaining > 0;)
+	{
+		const int64 ChunkSize = FMath::Min(Remaining, BlockSize);
+		if (!Read(Buffer.GetData(), ChunkSize))
+		{
+			if (Error.IsEmpty())
+			{
+				Error = FString::Printf(TEXT("Failed to read the compressed data of '%s'"), *NameInZip);
+			}
+			return false;
+		}
+		if (!Write(Buffer.GetData(), ChunkSize))
+		{
+			return false;
+		}
+		Remaining -= ChunkSize;
+	}
+
+	Entry.Crc = Crc;
+	return FinishEntry(MoveTemp(Entry), DataStart, NameInZip);
+}
+
+bool FModZipWriter::BeginEntry(const FString& NameInZip, int64 Size, EModZipMethod Method, const FDateTime& Timestamp, FEntry& Entry)
+{
+	using namespace ModZipWriter;
+
+	if (!Handle)
+	{
+		Error = TEXT("Zip is not open");
+		return false;
+	}
+
+	Error.Empty();
+	const FTCHARToUTF8 Utf8Name(*NameInZip.Replace(TEXT("\\"), TEXT("/")));
+	Entry.Name.Append((const uint8*)Utf8Name.Get(), Utf8Name.Length());
+	Entry.Flags = Entry.Name.ContainsByPredicate([](uint8 Char) { return Char >= 0x80; }) ? Utf8NameFlag : 0;
+	Entry.Method = Method == EModZipMethod::Deflate ? MethodDeflate : MethodStore;
+	Entry.DosTime = bDeterministic ? DeterministicDosTime : ToDosTime(Timestamp);
+	Entry.UncompressedSize = Size;
+	Entry.Offset = Handle->Tell();
+	Entry.bZip64 = (uint64)Size >= Zip64Threshold;
+
+	// CRC and sizes are patched in once the data is written, the zip stays seekable so no data descriptor is needed
+	FRecord Header;
+	Header.U32(LocalHeaderSignature).U16(Entry.bZip64 ? Zip64Version : Version).U16(Entry.Flags).U16(Entry.Method)
+		.U16(Entry.DosTime & 0xFFFF).U16(Entry.DosTime >> 16).U32(0).U32(0).U32(0)
+		.U16(Entry.Name.Num()).U16(Entry.bZip64 ? 20 : 0).Append(Entry.Name);
+	if (Entry.bZip64)
+	{
+		Header.U16(Zip64ExtraId).U16(16).U64(0).U64(0);
+	}
+
+	return Write(Header.Bytes);
+}
+
+bool FModZipWriter::FinishEntry(FEntry&& Entry, int64 DataStart, const FString& NameInZip)
+{
+	using namespace ModZipWriter;
+
+	const int64 DataEnd = Handle->Tell();
+	Entry.CompressedSize = DataEnd - DataStart;
+
+	if (!Entry.bZip64 && Entry.CompressedSize >= 0xFFFFFFFFull)
+	{
+		Error = FString::Printf(TEXT("'%s' grew past 4 GB while compressing"), *NameInZip);
+		return false;
+	}
+
+	FRecord Sizes;
+	Sizes.U32(Entry.Crc).U32(Entry.bZip64 ? 0xFFFFFFFFu : (uint32)Entry.CompressedSize).U32(Entry.bZip64 ? 0xFFFFFFFFu : (uint32)Entry.UncompressedSize);
+
+	bool bPatched = Handle->Seek(Entry.Offset + LocalHeaderCrcOffset) && Write(Sizes.Bytes);
+	if (bPatched && Entry.bZip64)
+	{
+		FRecord Zip64Sizes;
+		Zip64Sizes.U64(Entry.UncompressedSize).U64(Entry.CompressedSize);
+		bPatched = Handle->Seek(Entry.Offset + LocalHeaderSize + Entry.Name.Num() + 4) && Write(Zip64Sizes.Bytes);
+	}
+
+	if (!bPatched || !Handle->Seek(DataEnd))
+	{
+		Error = FString::Printf(TEXT("Failed to update the header of '%s'"), *NameInZip);
+		return false;
+	}
+
+	Entries.Add(MoveTemp(Entry));
+	return true;
+}
+
+bool FModZipWriter::WriteData(FEntry& Entry, int64 Size, TFunctionRef<bool(uint8* Buffer, int64 Num)> Read)
+{
+	const bool bDeflate = Entry.Method == ModZipWriter::MethodDeflate;
+	z_stream Stream = {};
+	if (bDeflate && deflateInit2(&Stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+	{
+		return false;
+	}
+	ON_SCOPE_EXIT
+	{
+		if (bDeflate)
+		{
+			deflateEnd(&Stream);
+		}
+	};
+
+	TArray<uint8> InBuffer;
+	InBuffer.SetNumUninitialized(BlockSize);
+	TArray<uint8> OutBuffer;
+	if (bDeflate)
+	{
+		OutBuffer.SetNumUninitialized(BlockSize);
+	}
+
+	uint32 Crc = crc32(0, nullptr, 0);
+	int64 Remaining = Size;
+	do
+	{
+		const int64 ChunkSize = FMath::Min(Remaining, BlockSize);
+		if (ChunkSize > 0 && !Read(InBuffer.GetData(), ChunkSize))
+		{
+			return false;
+		}
+		Remaining -= ChunkSize;
+		Crc = crc32(Crc, InBuffer.GetData(), ChunkSize);
+
+		if (!bDeflate)
+		{
+			if (!Write(InBuffer.GetData(), ChunkSize))
+			{
+				return false;
+			}
+			continue;
+		}
+
+		Stream.next_in = InBuffer.GetData();
+		Stream.avail_in = (uInt)ChunkSize;
+		const int32 Flush = Remaining == 0 ? Z_FINISH : Z_NO_FLUSH;
+		do
+		{
+			Stream.next_out = OutBuffer.GetData();
+			Stream.avail_out = (uInt)OutBuffer.Num();
+			if (deflate(&Stream, Flush) == Z_STREAM_ERROR || !Write(OutBuffer.GetData(), OutBuffer.Num() - Stream.avail_out))
+			{
+				return false;
+			}
+		}
+		while (Stream.avail_out == 0);
+	}
+	while (Remaining > 0);
+
+	Entry.Crc = Crc;
+	return true;
+}
+
+bool FModZipWriter::WriteDeflatedParallel(FEntry& Entry, int64 Size, int32 ThreadCount, TFunctionRef<bool(uint8* Buffer, int64 Num)> Read)
+{
+	using namespace ModZipWriter;
+
+	// One block per thread is in flight, so memory stays at a few MB per thread however large the file is
+	TArray<TArray<uint8>> InBlocks;
+	TArray<TArray<uint8>> OutBlocks;
+	TArray<uint32> BlockCrcs;
+	TArray<bool> BlockResults;
+	InBlocks.SetNum(ThreadCount);
+	OutBlocks.SetNum(ThreadCount);
+	BlockCrcs.SetNum(ThreadCount);
+	BlockResults.SetNum(ThreadCount);
+
+	// The end of the block before the current batch, deflate may refer back into it like a single stream would
+	TArray<uint8> Dictionary;
+
+	uint32 Crc = crc32(0, nullptr, 0);
+	int64 Remaining = Size;
+	while (Remaining > 0)
+	{
+		const int32 NumBlocks = (int32)FMath::Min<int64>(ThreadCount, FMath::DivideAndRoundUp(Remaining, BlockSize));
+		for (int32 Block = 0; Block < NumBlocks; Block++)
+		{
+			const int64 ChunkSize = FMath::Min(Remaining, BlockSize);
+			InBlocks[Block].SetNumUninitialized(ChunkSize);
+			if (!Read(InBlocks[Block].GetData(), ChunkSize))
+			{
+				return false;
+			}
+			Remaining -= ChunkSize;
+		}
+
+		const bool bLastBatch = Remaining == 0;
+		ParallelFor(NumBlocks, [&](int32 Block)
+		{
+			const TArray<uint8>& PreviousBlock = Block == 0 ? Dictionary : InBlocks[Block - 1];
+			const int64 DictionarySize = FMath::Min<int64>(PreviousBlock.Num(), DictionaryWindow);
+
+			BlockCrcs[Block] = crc32(0, InBlocks[Block].GetData(), InBlocks[Block].Num());
+			BlockResults[Block] = DeflateBlock(InBlocks[Block], PreviousBlock.GetData() + PreviousBlock.Num() - DictionarySize, DictionarySize,
+				bLastBatch && Block == NumBlocks - 1, OutBlocks[Block]);
+		});
+
+		for (int32 Block = 0; Block < NumBlocks; Block++)
+		{
+			if (!BlockResults[Block] || !Write(OutBlocks[Block]))
+			{
+				return false;
+			}
+			Crc = crc32_combine(Crc, BlockCrcs[Block], InBlocks[Block].Num());
+		}
+
+		const TArray<uint8>& LastBlock = InBlocks[NumBlocks - 1];
+		const int64 DictionarySize = FMath::Min<int64>(LastBlock.Num(), DictionaryWindow);
+		Dictionary.Reset();
+		Dictionary.Append(LastBlock.GetData() + LastBlock.Num() - DictionarySize, DictionarySize);
+	}
+
+	Entry.Crc = Crc;
+	return true;
+}
+
+int32 FModZipWriter::GetNumThreads() const
+{
+	return NumThreads > 0 ? NumThreads : FMath::Max(1, FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+}
+
+bool FModZipWriter::Close()
+{
+	using namespace ModZipWriter;
+
+	if (!Handle)
+	{
+		Error = TEXT("Zip is not open");
+		return false;
+	}
+
+	const uint64 CentralDirOffset = Handle->Tell();
+
+	FRecord CentralDir;
+	for (const FEntry& Entry : Entries)
+	{
+		// Only the fields that don't fit are moved to the Zip64 extra field, in this order
+		FRecord Zip64Extra;
+		if (Entry.UncompressedSize >= 0xFFFFFFFFull)
+		{
+			Zip64Extra.U64(Entry.UncompressedSize);
+		}
+		if (Entry.CompressedSize >= 0xFFFFFFFFull)
+		{
+			Zip64Extra.U64(Entry.CompressedSize);
+		}
+		if (Entry.Offset >= 0xFFFFFFFFull)
+		{
+			Zip64Extra.U64(Entry.Offset);
+		}
+
+		const bool bNeedsZip64 = !Zip64Extra.Bytes.IsEmpty();
+		const uint16 NeededVersion = bNeedsZip64 || Entry.bZip64 ? Zip64Version : Version;
+
+		CentralDir.U32(CentralHeaderSignature).U16(NeededVersion).U16(NeededVersion).U16(Entry.Flags).U16(Entry.Method)
+			.U16(Entry.DosTime & 0xFFFF).U16(Entry.DosTime >> 16).U32(Entry.Crc)
+			.U32(Clamp32(Entry.CompressedSize)).U32(Clamp32(Entry.UncompressedSize))
+			.U16(Entry.Name.Num()).U16(bNeedsZip64 ? Zip64Extra.Bytes.Num() + 4 : 0).U16(0).U16(0).U16(0).U32(0)
+			.U32(Clamp32(Entry.Offset)).Append(Entry.Name);
+		if (bNeedsZip64)
+		{
+			CentralDir.U16(Zip64ExtraId).U16(Zip64Extra.Bytes.Num()).Append(Zip64Extra.Bytes);
+		}
+	}
+
+	const uint64 CentralDirSize = CentralDir.Bytes.Num();
+	const uint64 NumEntries = Entries.Num();
+
+	FRecord End;
+	if (NumEntries >= 0xFFFF || CentralDirOffset >= 0xFFFFFFFFull || CentralDirSize >= 0xFFFFFFFFull)
+	{
+		const uint64 Zip64EndOffset = CentralDirOffset + CentralDirSize;
+		End.U32(Zip64EndOfCentralDirSignature).U64(44).U16(Zip64Version).U16(Zip64Version).U32(0).U32(0)
+			.U64(NumEntries).U64(NumEntries).U64(CentralDirSize).U64(CentralDirOffset);
+		End.U32(Zip64LocatorSignature).U32(0).U64(Zip64EndOffset).U32(1);
+	}
+	End.U32(EndOfCentralDirSignature).U16(0).U16(0).U16(FMath::Min<uint64>(NumEntries, 0xFFFF)).U16(FMath::Min<uint64>(NumEntries, 0xFFFF))
+		.U32(Clamp32(CentralDirSize)).U32(Clamp32(CentralDirOffset)).U16(0);
+
+	if (!Write(CentralDir.Bytes) || !Write(End.Bytes) || !Handle->Flush())
+	{
+		return false;
+	}
+
+	Handle.Reset();
+	return true;
+}
+
+bool FModZipWriter::Write(const TArray<uint8>& Bytes)
+{
+	return Write(Bytes.GetData(), Bytes.Num());
+}
+
+bool FModZipWriter::Write(const uint8* Bytes, int64 Num)
+{
+	if (Num > 0 && !Handle->Write(Bytes, Num))
+	{
+		Error = FString::Printf(TEXT("Failed to write to '%s', the disk may be full"), *ZipPath);
+		return false;
+	}
+	return true;
+}
@@ -59,6 +59,25 @@ bool FZipFile::TryCreateZipFile(const TArray<uint8>& Data, FZipFile& ZipFile, FZ
 	return true;
 }
 
+bool FZipFile::TryOpenZipFile(const FString& Path, FZipFile& ZipFile, FZipError& Error)
+{
+	int ErrorCode = 0;
+	zip_t* Zip = zip_open(TCHAR_TO_UTF8(*Path), ZIP_RDONLY, &ErrorCode);
+	if (!Zip)
+	{
+		zip_error_t ZipError{};
+		zip_error_init_with_code(&ZipError, ErrorCode);
+		zip_error_strerror(&ZipError);
+		Error = CreateError(ZipError);
+		zip_error_fini(&ZipError);
+		return false;
+	}
+
+	// Opened from the path, there is no buffer to keep alive
+	ZipFile = FZipFile(FZipBuffer(nullptr), Zip);
+	return true;
+}
+
 TOptional<FZipEntry> FZipFile::GetEntry(const FString& Name, FZipError& Error) const
 {
 	if (!Zip) return NullOpt;
@@ -72,7 +91,7 @@ TOptional<FZipEntry> FZipFile::GetEntry(const FString& Name, FZipError& Error) c
 	return GetEntryIndex(EntryIndex, Error);
 }
 
-TOptional<FZipEntry> FZipFile::GetEntryIndex(uint64 Index, FZipError& Error) const
+TOptional<FZipEntry> FZipFile::GetEntryIndex(uint64 Index, FZipError& Error, bool bCompressed) const
 {
 	zip_stat_t EntryStat{};
 	if (zip_stat_index(Zip, Index, 0, &EntryStat) != 0)
@@ -80,7 +99,7 @@ TOptional<FZipEntry> FZipFile::GetEntryIndex(uint64 Index, FZipError& Error) con
 		return NullOpt;
 	}
 
-	zip_file* File = zip_fopen_index(Zip, Index, 0);
+	zip_file* File = zip_fopen_index(Zip, Index, bCompressed ? ZIP_FL_COMPRESSED : 0);
 	if (!File)
 	{
 		const zip_error_t* ZipError = zip_get_error(Zip);
@@ -96,6 +115,8 @@ TOptional<FZipEntry> FZipFile::GetEntryIndex(uint64 Index, FZipError& Error) con
 	Entry.Index = Index;
 	Entry.DecompressedSize = EntryStat.size;
 	Entry.CompressedSize = EntryStat.comp_size;
+	Entry.Crc = EntryStat.crc;
+	Entry.CompressionMethod = EntryStat.comp_method;
 	Entry.File = File;
 
 	return Entry;
@@ -145,6 +166,24 @@ TArray<uint8> FZipFile::ReadEntry(const FZipEntry& Entry) const
 	return Array;
 }
 
+bool FZipFile::ReadEntry(const FZipEntry& Entry, uint8* Buffer, int64 Num) const
+{
+	if (!Zip) return false;
+
+	while (Num > 0)
+	{
+		const int64 ReadBytes = zip_fread(Entry.File, Buffer, Num);
+		if (ReadBytes <= 0)
+		{
+			return false;
+		}
+		Buffer += ReadBytes;
+		Num -= ReadBytes;
+	}
+
+	return true;
+}
+
 
 FZipFile::~FZipFile()
 {
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FModBuildContext;
+struct FModBuildOutputFile;
+
+/**
+ * Content-addressed cache of built paks in Intermediate/ModdingExCache, so switching branches or toggling
+ * between two versions of a mod deploys the already built files instead of cooking again.
+ * Every entry is a folder named after its key, the least recently used entries are evicted once the cache exceeds its size cap.
+ */
+namespace ModBuildCache
+{
+	FString GetCacheDir();
+
+	/** Key over the hashed mod assets, the referenced assets outside the mod and everything in the build settings that changes the paks, empty if the inputs aren't known */
+	FString ComputeKey(const FModBuildContext& Context);
+
+	/**
+	 * Look up the files of a cache entry and mark it as used
+	 *
+	 * @param Key Key of the entry
+	 * @param FileNames Names of the files the entry must contain
+	 * @param OutFilePaths Paths of the cached files, in the order of FileNames
+	 */
+	bool Find(const FString& Key, const TArray<FString>& FileNames, TArray<FString>& OutFilePaths);
+
+	/** Add the staged files of a build under the key, block cloned where the volume supports it so storing costs no copy */
+	bool Store(const FString& Key, const TArray<FModBuildOutputFile>& Files);
+
+	/** Delete the least recently used entries until the cache is at most MaxBytes, the entry KeepKey is never deleted */
+	void Evict(int64 MaxBytes, const FString& KeepKey);
+}
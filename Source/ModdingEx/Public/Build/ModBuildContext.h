@@ -0,0 +1,128 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+#include "Build/ModBuildManifest.h"
+#include "Build/ModCookSet.h"
+#include "Build/ModBuildProfiler.h"
+#include "Build/ModBuildProgress.h"
+
+class FModBuildNotification;
+
+/** A built file in the staging dir and where it gets deployed to */
+struct FModBuildOutputFile
+{
+	FString SourcePath;
+	FString DestPath;
+};
+
+/** State of a single mod build, shared between the game thread and the thread running UAT */
+struct FModBuildContext
+{
+	FString ModName;
+
+	/** Compare the built files against the deployed ones and skip deploying if they match */
+	bool bCheckHash = true;
+
+	/** Mods cooked together in a single UAT run and the chunk each one's pak is split out of, empty when building one mod */
+	TMap<FString, int32> BatchChunkIds;
+
+	/** Build even if the manifest says nothing changed since the last build, also bypasses the build cache and repacking */
+	bool bForceRebuild = false;
+
+	/** bSkipBuildIfUnchanged at the start of the build. Off only stops skipping, the cache and repacking still apply */
+	bool bSkipIfUnchanged = false;
+
+	bool bUseIoStore = false;
+	FString PlatformName = TEXT("Win64");
+
+	/** Whether UAT compiles the game target, live coding is disabled for the build only then */
+	bool bBuildCode = false;
+
+	/** Dirty packages outside the mods that were left unsaved, listed in the build summary */
+	TArray<FString> UnsavedPackages;
+
+	/** Packages passed to UAT, empty if the mod dirs are cooked as a whole */
+	FModCookSet CookSet;
+
+	/** Whether the cook got the resolved package list. With -CookDir the cooker pulls in references nobody listed, so the pak needs UAT */
+	bool bCookSetResolved = false;
+
+	/** Package files of CookSet.ExternalPackages, hashed as inputs next to the mod dir since they end up in the pak too */
+	TArray<FString> ExternalPackageFiles;
+
+	FString UatPath;
+	FString UatArgs;
+
+	FString TempStagingDir;
+
+	/** Staging and cook dirs are stable per mod and kept after the build, so UAT can cook iteratively */
+	bool bPersistentStaging = false;
+	FString CookOutputDir;
+	FString FinalDestinationDir;
+
+	/** Manifest of the last successful build and what the current one gets compared against */
+	FModBuildManifest PreviousManifest;
+	bool bHasPreviousManifest = false;
+	FModBuildSettingsSnapshot BuildSettings;
+	TArray<FModBuildManifestFile> Inputs;
+
+	/** Set when the assets are unchanged and still cooked, so only UnrealPak has to run */
+	bool bPackageOnly = false;
+
+	/** Set when nothing changed since the last build and UAT was skipped */
+	bool bUpToDate = false;
+
+	/** Key of the build in the build cache, empty if the cache isn't used for this build */
+	FString CacheKey;
+
+	/** Set when the output files were taken from the build cache instead of being built */
+	bool bFromCache = false;
+
+	TArray<FModBuildOutputFile> OutputFiles;
+	bool bContentUnchanged = false;
+
+	/** Times the phases of the build, appended to the build history once it finishes */
+	FModBuildProfiler Profiler;
+	FModBuildProgress Progress;
+
+	/** UAT warnings and errors and anything else worth a look that didn't fail the build, collected for the build report */
+	TArray<FString> Warnings;
+
+	/** Phase timings of the finished build, filled once it was appended to the build history */
+	FModBuildRecord Record;
+
+	/** Set from the game thread to stop the build, the running tool is killed and nothing gets deployed */
+	std::atomic<bool> bCancelRequested = false;
+
+	/** Set when UAT was killed, the cooker may have left truncated packages in the cook dir */
+	bool bUatInterrupted = false;
+
+	/** Set by the steps running off the game thread, shown once the build finishes */
+	FString ErrorMessage;
+
+	/** Set for background builds, errors are reported through it instead of modal dialogs */
+	TSharedPtr<FModBuildNotification> Notification;
+
+	bool IsBatch() const { return !BatchChunkIds.IsEmpty(); }
+
+	/** All mods this build produces */
+	TArray<FString> GetModNames() const
+	{
+		TArray<FString> ModNames;
+		if (IsBatch())
+		{
+			BatchChunkIds.GetKeys(ModNames);
+		}
+		else
+		{
+			ModNames.Add(ModName);
+		}
+		return ModNames;
+	}
+
+	explicit FModBuildContext(FString InModName, bool bInCheckHash = true) : ModName(MoveTemp(InModName)),
+		bCheckHash(bInCheckHash)
+	{
+	}
+};
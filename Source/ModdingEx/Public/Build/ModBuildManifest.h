@@ -0,0 +1,113 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "ModBuildManifest.generated.h"
+
+USTRUCT()
+struct FModBuildManifestFile
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString Path;
+
+	UPROPERTY()
+	int64 Size = 0;
+
+	/** Modification time in ticks, stored as a string because json numbers can't hold all int64 values */
+	UPROPERTY()
+	FString Timestamp;
+
+	/** SHA1 of the content, empty for deployed outputs which are only checked by size and timestamp */
+	UPROPERTY()
+	FString Hash;
+};
+
+/** Everything besides the mod assets that changes the built paks */
+USTRUCT()
+struct FModBuildSettingsSnapshot
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString EngineVersion;
+
+	UPROPERTY()
+	FString Platform;
+
+	UPROPERTY()
+	bool bUseIoStore = false;
+
+	UPROPERTY()
+	bool bCompressed = false;
+
+	UPROPERTY()
+	FString CompressionFormats;
+
+	UPROPERTY()
+	FString CompressionOptions;
+
+	UPROPERTY()
+	FString OutputDir;
+
+	bool operator==(const FModBuildSettingsSnapshot& Other) const
+	{
+		return EngineVersion == Other.EngineVersion && Platform == Other.Platform && bUseIoStore == Other.bUseIoStore &&
+			bCompressed == Other.bCompressed && CompressionFormats == Other.CompressionFormats &&
+			CompressionOptions == Other.CompressionOptions && OutputDir == Other.OutputDir;
+	}
+
+	bool operator!=(const FModBuildSettingsSnapshot& Other) const
+	{
+		return !(*this == Other);
+	}
+};
+
+/** Inputs and outputs of the last successful build of a mod, stored in Intermediate */
+USTRUCT()
+struct FModBuildManifest
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FModBuildSettingsSnapshot Settings;
+
+	/** Files under Content/Mods/<ModName>, paths relative to the project dir */
+	UPROPERTY()
+	TArray<FModBuildManifestFile> Inputs;
+
+	/** Deployed files, absolute paths */
+	UPROPERTY()
+	TArray<FModBuildManifestFile> Outputs;
+
+	/** Persistent cook dir the build cooked into, empty if it didn't cook there. The Auto staging location can move the dir between builds */
+	UPROPERTY()
+	FString CookOutputDir;
+};
+
+namespace ModBuildManifest
+{
+	FString GetManifestPath(const FString& ModName);
+
+	bool Load(const FString& ModName, FModBuildManifest& OutManifest);
+	bool Save(const FString& ModName, const FModBuildManifest& Manifest);
+	void Delete(const FString& ModName);
+
+	/**
+	 * Stat and hash all files of a mod. Hashes are taken from the previous manifest if size and timestamp didn't change
+	 *
+	 * @param ModName Mod to collect the files of
+	 * @param ExternalFiles Files outside the mod dir that are cooked into the mod, like referenced assets
+	 * @param Previous Manifest of the last build, used to skip hashing untouched files
+	 * @param OutInputs Collected files, sorted by path
+	 */
+	void CollectInputs(const FString& ModName, const TArray<FString>& ExternalFiles, const FModBuildManifest* Previous, TArray<FModBuildManifestFile>& OutInputs);
+
+	/** Record the current size and timestamp of deployed files */
+	void CollectOutputs(const TArray<FString>& FilePaths, TArray<FModBuildManifestFile>& OutOutputs);
+
+	/** Check if the deployed files still have the size and timestamp recorded after the last build */
+	bool AreOutputsDeployed(const FModBuildManifest& Manifest);
+
+	bool AreInputsEqual(const TArray<FModBuildManifestFile>& InputsA, const TArray<FModBuildManifestFile>& InputsB);
+}
@@ -0,0 +1,35 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+class SNotificationItem;
+
+/**
+ * Non-modal progress notification for builds running in the background.
+ * Has to be created and completed on the game thread, the progress text can be updated from any thread.
+ */
+class FModBuildNotification : public TSharedFromThis<FModBuildNotification>
+{
+public:
+	/**
+	 * @param Title Shown as the main text until the build completes
+	 * @param OnCancel Called when the cancel button is clicked, there is no button if it is unbound
+	 */
+	explicit FModBuildNotification(const FText& Title, FSimpleDelegate OnCancel = FSimpleDelegate());
+
+	/** Update the line shown below the title, coalesces updates until the game thread picks them up */
+	void SetProgressText(const FString& Text);
+
+	/** Switch to the success/fail state and fade out */
+	void Complete(bool bSuccess, const FText& Text);
+
+private:
+	void ApplyPendingText();
+
+private:
+	TSharedPtr<SNotificationItem> Item;
+
+	FCriticalSection PendingLock;
+	FString PendingText;
+	bool bUpdateQueued = false;
+};
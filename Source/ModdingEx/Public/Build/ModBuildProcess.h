@@ -0,0 +1,52 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Runs an external tool (UAT) and streams its combined stdout/stderr line by line.
+ * Run blocks the calling thread until the process exits, so it should be called from a background thread.
+ */
+class FModBuildProcess
+{
+public:
+	FModBuildProcess(FString InExecutable, FString InParams);
+
+	/**
+	 * Start the process and wait for it to exit
+	 *
+	 * @param OutReturnCode Exit code of the process, gets set if the process could be started
+	 * @return Returns if the process could be started
+	 */
+	bool Run(int32& OutReturnCode);
+
+	/** Whether Run stopped the process because ShouldCancel returned true */
+	bool WasCancelled() const { return bCancelled; }
+
+	/** Last line printed by the process, can be called from any thread */
+	FString GetLastLine() const;
+
+	const FString& GetExecutable() const { return Executable; }
+	const FString& GetParams() const { return Params; }
+
+public:
+	/** Called on the thread executing Run for every complete output line */
+	TFunction<void(const FString& Line)> OnOutput;
+
+	/** Polled on the thread executing Run, the process and all processes it started are killed once it returns true */
+	TFunction<bool()> ShouldCancel;
+
+	/** Environment variables only the process gets, the editor's own environment is left as it was */
+	TMap<FString, FString> Environment;
+
+private:
+	void EmitLines(FString& Buffer, bool bFlush);
+
+private:
+	FString Executable;
+	FString Params;
+
+	bool bCancelled = false;
+
+	mutable FCriticalSection LastLineLock;
+	FString LastLine;
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EModBuildPhase : uint8
+{
+	SavePackages,
+	/** UAT startup and the time between its commands */
+	Uat,
+	Compile,
+	Cook,
+	Stage,
+	Pak,
+	IoStore,
+	Package,
+	Copy,
+	Zip,
+	Num
+};
+
+const TCHAR* LexToString(EModBuildPhase Phase);
+
+/** Timing and memory of a single build, one line in the build history */
+struct FModBuildRecord
+{
+	FDateTime Time;
+	FString ModName;
+	FString Result;
+	FString EngineVersion;
+	/** Crc of the packaging settings, a change shows that a regression could come from the settings */
+	FString SettingsHash;
+	int32 InputFiles = 0;
+	int64 InputBytes = 0;
+	double TotalSeconds = 0.0;
+	double PhaseSeconds[(int32)EModBuildPhase::Num] = {};
+	/** Peak of the used physical memory of the whole system during a phase, covers the cooker running in its own process */
+	double PhasePeakMemoryMB[(int32)EModBuildPhase::Num] = {};
+};
+
+/**
+ * Measures the phases of a build. Phases switch either explicitly or from the markers UAT prints into its output.
+ * Can be used from the game thread and the thread running UAT at the same time.
+ */
+class FModBuildProfiler
+{
+public:
+	FModBuildProfiler();
+
+	/** End the current phase and start the given one */
+	void BeginPhase(EModBuildPhase Phase);
+	void EndPhase();
+
+	/** Switch phases based on the command markers of BuildCookRun and the tools it runs */
+	void ProcessUatLine(const FString& Line);
+
+	/** Update the memory peak of the current phase */
+	void SampleMemory();
+
+	TOptional<EModBuildPhase> GetCurrentPhase() const;
+
+	/** Seconds since the build started */
+	double GetElapsedSeconds() const;
+
+	/** End the current phase and fill the timings of the record */
+	void Finish(FModBuildRecord& OutRecord);
+
+private:
+	void EndPhaseLocked(double Now);
+	void SampleMemoryLocked();
+
+private:
+	mutable FCriticalSection Lock;
+
+	double StartTime = 0.0;
+	double PhaseStartTime = 0.0;
+	TOptional<EModBuildPhase> CurrentPhase;
+
+	double PhaseSeconds[(int32)EModBuildPhase::Num] = {};
+	double PhasePeakMemoryMB[(int32)EModBuildPhase::Num] = {};
+};
+
+/** Every build appends a line to Saved/ModdingEx/BuildHistory.csv */
+namespace ModBuildHistory
+{
+	FString GetHistoryPath();
+
+	void Append(const FModBuildRecord& Record);
+
+	/** Load all records, oldest first */
+	void Load(TArray<FModBuildRecord>& OutRecords);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Build/ModBuildProfiler.h"
+
+/**
+ * Estimates how far a build is, from the package counts the cooker prints, the chunk counts the IoStore commandlet prints,
+ * the size of the paks being written for UnrealPak, and the phase timings of the previous build of the same mod.
+ * Can be fed and read from any thread.
+ */
+class FModBuildProgress
+{
+public:
+	/**
+	 * @param InStagingDir Dir UAT writes the paks to, its size is tracked while packing
+	 * @param InPreviousRecord Last successful build of the same mod, the ETA is based on it
+	 */
+	void Start(const FString& InStagingDir, const TOptional<FModBuildRecord>& InPreviousRecord);
+
+	/** Pick up the cooked package count or the serialized chunk count from a line of UAT or IoStore output */
+	void ProcessLine(const FString& Line);
+
+	/** Progress between 0 and 1, negative if there is nothing to base it on */
+	float GetFraction(const FModBuildProfiler& Profiler) const;
+
+	/** Extra line shown with the status, like what a deploy is waiting for. Empty to clear it */
+	void SetDetail(const FString& InDetail);
+
+	/** Phase, counts, throughput and ETA as a single line */
+	FString GetStatus(const FModBuildProfiler& Profiler) const;
+
+	/** Find the last successful build of a mod in the build history */
+	static TOptional<FModBuildRecord> FindPreviousRecord(const FString& ModName);
+
+private:
+	/** Seconds the build will still take, unset if unknown */
+	TOptional<double> GetRemainingSeconds(const FModBuildProfiler& Profiler) const;
+
+	/** Update the size of the written paks, at most once per second */
+	void SampleOutputSize() const;
+
+	static FString FormatDuration(double Seconds);
+
+private:
+	mutable FCriticalSection Lock;
+
+	FString StagingDir;
+	FString Detail;
+	TOptional<FModBuildRecord> PreviousRecord;
+
+	int32 CookedPackages = 0;
+	int32 TotalPackages = 0;
+	int32 FirstCookedPackages = 0;
+	double FirstCookSampleTime = 0.0;
+	double LastCookSampleTime = 0.0;
+
+	int32 PackedItems = 0;
+	int32 TotalPackItems = 0;
+
+	mutable int64 OutputBytes = 0;
+	mutable double OutputBytesPerSecond = 0.0;
+	mutable double LastOutputSampleTime = 0.0;
+};
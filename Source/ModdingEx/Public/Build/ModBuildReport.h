@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ModBuildReport.generated.h"
+
+USTRUCT()
+struct FModBuildReportFile
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString Path;
+
+	UPROPERTY()
+	int64 Size = 0;
+
+	UPROPERTY()
+	FString Sha1;
+};
+
+USTRUCT()
+struct FModBuildReportMod
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString ModName;
+
+	/** Name of the EModBuildResult, or ZipFailed/StageFailed if the build succeeded but a later step didn't */
+	UPROPERTY()
+	FString Result;
+
+	/** Why the build failed, empty if it didn't */
+	UPROPERTY()
+	FString Error;
+
+	UPROPERTY()
+	double TotalSeconds = 0.0;
+
+	/** Seconds per build phase, phases that didn't run are left out */
+	UPROPERTY()
+	TMap<FString, double> PhaseSeconds;
+
+	/** Deployed paks and IoStore containers */
+	UPROPERTY()
+	TArray<FModBuildReportFile> Outputs;
+
+	/** Empty path if the mod wasn't zipped */
+	UPROPERTY()
+	FModBuildReportFile Zip;
+
+	UPROPERTY()
+	TArray<FString> Warnings;
+};
+
+/** Result of a headless build run, written as json for CI */
+USTRUCT()
+struct FModBuildReport
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString Time;
+
+	UPROPERTY()
+	FString EngineVersion;
+
+	UPROPERTY()
+	FString Platform;
+
+	UPROPERTY()
+	int32 Parallelism = 1;
+
+	UPROPERTY()
+	double TotalSeconds = 0.0;
+
+	UPROPERTY()
+	bool bSucceeded = false;
+
+	UPROPERTY()
+	TArray<FModBuildReportMod> Mods;
+};
+
+namespace ModBuildReport
+{
+	/** Stat and hash a file, false if it doesn't exist */
+	bool DescribeFile(const FString& FilePath, FModBuildReportFile& OutFile);
+
+	bool Save(const FString& ReportPath, const FModBuildReport& Report);
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "ModBuilder.h"
+#include "Containers/Ticker.h"
+
+struct FModBuildContext;
+
+enum class EModBuildQueueState : uint8
+{
+	Queued,
+	Building,
+	Built,
+	Unchanged,
+	Failed,
+	Cancelled
+};
+
+const TCHAR* LexToString(EModBuildQueueState State);
+
+/** A mod waiting for, running or done with its build in the queue */
+struct FModBuildQueueItem
+{
+	FString ModName;
+	EModBuildQueueState State = EModBuildQueueState::Queued;
+	bool bForceRebuild = false;
+
+	/** Set once the build started, holds its progress and results */
+	TSharedPtr<FModBuildContext> Context;
+	TFuture<EModBuildResult> Future;
+	EModBuildResult Result = EModBuildResult::Failed;
+
+	double StartTime = 0.0;
+	double EndTime = 0.0;
+
+	bool IsFinished() const { return State != EModBuildQueueState::Queued && State != EModBuildQueueState::Building; }
+};
+
+/**
+ * Builds queued mods side by side, each one in its own UAT run with its own staging and cook dir.
+ * How many run at once is bounded by the cores and the physical memory, since every cooker takes several GB.
+ * Lives on the game thread and is driven by the core ticker.
+ */
+class FModBuildScheduler
+{
+public:
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnBuildFinished, const FModBuildQueueItem&);
+
+	static FModBuildScheduler& Get();
+
+	/** Queue the mods, mods already waiting or building are skipped. Builds start on the next tick */
+	void Enqueue(const TArray<FString>& ModNames, bool bForceRebuild = false);
+
+	/** Drop the mod from the queue if it's waiting or cancel its build if it's running */
+	void Cancel(const FString& ModName);
+	void CancelAll();
+
+	/** Remove finished builds from the list */
+	void ClearFinished();
+
+	/** Cancel everything and stop ticking, called when the module shuts down */
+	void Shutdown();
+
+	bool IsIdle() const;
+
+	const TArray<TSharedRef<FModBuildQueueItem>>& GetItems() const { return Items; }
+
+	/** Builds allowed to run at once, from MaxParallelBuilds or the cores and memory of this machine */
+	int32 GetMaxConcurrency() const;
+
+	/** Overrides MaxParallelBuilds until reset to 0, the commandlet passes -Parallel through this */
+	void SetMaxConcurrencyOverride(int32 InMaxConcurrency) { MaxConcurrencyOverride = InMaxConcurrency; }
+
+	/** Platform the queued mods are built for */
+	void SetPlatformName(const FString& InPlatformName) { PlatformName = InPlatformName; }
+
+	/** Physical memory not in use right now in MB */
+	static int64 GetAvailableMemoryMB();
+
+	/** Fired on the game thread once a build finished, before the item shows up as finished */
+	FOnBuildFinished OnBuildFinished;
+
+	/** Fired whenever an item was added, started, finished or removed */
+	FSimpleMulticastDelegate OnChanged;
+
+private:
+	bool Tick(float DeltaTime);
+
+	/** Start queued builds as long as the concurrency and the free memory allow */
+	void StartBuilds();
+
+	int32 GetNumBuilding() const;
+
+	TArray<TSharedRef<FModBuildQueueItem>> Items;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	/** Set once a build of the current queue finished, until then builds run alone since the first one may compile the game */
+	bool bFirstBuildFinished = false;
+
+	int32 MaxConcurrencyOverride = 0;
+	FString PlatformName = TEXT("Win64");
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace ModChunks
+{
+	/** Chunk IDs below this are left to the game, new mods get the next free ID above it */
+	constexpr int32 FirstModChunkId = 100;
+
+	/**
+	 * Get the chunk a mod is cooked into. An existing Primary Asset Label in the mod folder wins,
+	 * otherwise the ID stored in ModChunkIds is used or the next ID no label or setting uses is assigned and a label is created for it.
+	 * An ID another mod already uses is an error, nothing is saved then.
+	 * Must be called on the game thread.
+	 *
+	 * @param ModName Mod to resolve the chunk of
+	 * @param OutChunkId Chunk the mod's assets end up in
+	 * @return false if the label couldn't be created or saved
+	 */
+	bool ResolveChunkId(const FString& ModName, int32& OutChunkId);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Packages a mod build cooks, resolved from the Asset Registry instead of cooking the whole mod folder */
+struct FModCookSet
+{
+	/** The mod's own packages and everything they reference, sorted */
+	TArray<FName> Packages;
+
+	/** Referenced packages outside Content/Mods/<ModName>, they end up in the mod's pak as well */
+	TArray<FName> ExternalPackages;
+};
+
+namespace ModCookSet
+{
+	/** Package lists longer than this are not passed to UAT, the command line would get too long for Windows */
+	constexpr int32 MaxPackageListLength = 24000;
+
+	/**
+	 * Walk the dependency graph of the Asset Registry starting at the ModActor and every asset in the mod folder.
+	 * Engine and script packages are skipped, they are part of the game already. Must be called on the game thread.
+	 *
+	 * @param ModName Mod to collect the packages of
+	 * @param OutCookSet Appended to, so the sets of several mods can be collected into one
+	 * @return false if the Asset Registry is still scanning or the mod has no assets
+	 */
+	bool Collect(const FString& ModName, FModCookSet& OutCookSet);
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Build/ModBuildContext.h"
+
+enum class EModDeployMethod : uint8
+{
+	Rename,
+	Reflink,
+	Copy
+};
+
+const TCHAR* LexToString(EModDeployMethod Method);
+
+/** A process that has a deployed file open */
+struct FModDeployLockHolder
+{
+	uint32 ProcessId = 0;
+
+	/** Executable name like FModel.exe, or the display name if the executable can't be queried */
+	FString Name;
+};
+
+struct FModDeployOptions
+{
+	/** How long to wait for processes to close the deployed files before giving up or killing them */
+	float LockTimeoutSeconds = 10.0f;
+
+	/** Processes that may be killed if they still hold the files open after the timeout */
+	TArray<FString> ProcessesToKill;
+
+	/** Keep the source files, set when deploying from the build cache */
+	bool bKeepSources = false;
+
+	/** Polled while waiting for the files to be released, the deploy gives up and leaves the old files in place once it returns true */
+	TFunction<bool()> ShouldCancel;
+
+	/** Gets a line describing what the deploy is waiting for, called on the deploying thread */
+	TFunction<void(const FString& Status)> OnStatus;
+};
+
+/** Moves built files into the game folder with as little copying as the filesystem allows */
+namespace ModDeploy
+{
+	/**
+	 * Deploy a file, replacing the destination. Tries, in order: a rename if the source isn't kept, a reflink on volumes with
+	 * block cloning (ReFS, Dev Drive), and a chunked copy. Renames and reflinks need both paths on the same volume.
+	 *
+	 * @param SourcePath File to deploy
+	 * @param DestPath Where the file should end up
+	 * @param bKeepSource Whether the source still has to exist afterwards, otherwise it may be moved
+	 * @param OutMethod How the file was deployed
+	 * @return false if the file couldn't be deployed in any way
+	 */
+	bool DeployFile(const FString& SourcePath, const FString& DestPath, bool bKeepSource, EModDeployMethod& OutMethod);
+
+	/**
+	 * Deploy a set of files so the game folder either has all old or all new files, never a half-written one.
+	 * The files are written to <Dest>.tmp first and swapped in by renames once no process holds the old files open.
+	 * Blocks while waiting, so call it off the game thread.
+	 *
+	 * @param Files Files to deploy, the sources are moved if possible unless Options.bKeepSources is set
+	 * @param Options Timeout and processes that may be killed as a last resort
+	 * @param OutError Reason the deploy failed, the previously deployed files are left untouched then
+	 */
+	bool DeployFilesAtomic(const TArray<FModBuildOutputFile>& Files, const FModDeployOptions& Options, FString& OutError);
+
+	/** Find the processes that have any of the files open, only supported on Windows */
+	void FindLockHolders(const TArray<FString>& FilePaths, TArray<FModDeployLockHolder>& OutHolders);
+
+	/** Copy with a large buffer, avoids the small default buffer of IFileManager::Copy */
+	bool CopyFileChunked(const FString& SourcePath, const FString& DestPath);
+}
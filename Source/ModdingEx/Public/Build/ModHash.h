@@ -0,0 +1,19 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/SecureHash.h"
+
+namespace ModHash
+{
+	/**
+	 * Hash a file by streaming it in fixed size chunks, so memory use doesn't depend on the file size
+	 *
+	 * @param FilePath File to hash
+	 * @param OutHash Result hash, gets set if the file could be read
+	 * @return Returns if the file could be read
+	 */
+	bool HashFile(const FString& FilePath, FSHAHash& OutHash);
+
+	/** Check if two files have the same content, compares sizes before hashing. Missing files are never equal */
+	bool AreFilesEqual(const FString& FilePathA, const FString& FilePathB);
+}
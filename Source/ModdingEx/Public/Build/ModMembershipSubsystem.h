@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "Build/ModCookSet.h"
+#include "ModMembershipSubsystem.generated.h"
+
+enum class EModPackageSaveResult : uint8
+{
+	Saved,
+	/** The packages of the mods aren't known yet, nothing was saved */
+	NotResolved,
+	/** Saving failed or the checkout prompt was cancelled */
+	Failed
+};
+
+/**
+ * Knows which packages belong to which mod: the mod's own assets and everything they reference, as resolved from the Asset Registry.
+ * The sets are computed on first use and dropped whenever the Asset Registry reports an added, removed or renamed asset or a package is saved.
+ */
+UCLASS()
+class UModMembershipSubsystem : public UEditorSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * Get the packages a mod is made of
+	 *
+	 * @param ModName Mod to get the packages of
+	 * @param OutCookSet Filled with the mod's packages, appended to so the sets of several mods can be merged
+	 * @return false if the set couldn't be resolved, see ModCookSet::Collect
+	 */
+	bool GetModPackages(const FString& ModName, FModCookSet& OutCookSet);
+
+	bool IsPackageInMod(FName PackageName, const FString& ModName);
+
+	/** Split the dirty content and map packages into the ones belonging to any of the mods and the rest */
+	bool GetDirtyPackages(const TArray<FString>& ModNames, TArray<UPackage*>& OutModPackages, TArray<UPackage*>& OutUnrelatedPackages);
+
+	/**
+	 * Save the dirty packages of the mods without prompting and leave everything else untouched.
+	 * Repeats until no dirty package is newly referenced by what was just saved
+	 *
+	 * @param ModNames Mods about to be built
+	 * @param OutUnrelatedPackages Names of the dirty packages that were not saved because they don't belong to the mods
+	 */
+	EModPackageSaveResult SaveDirtyModPackages(const TArray<FString>& ModNames, TArray<FString>& OutUnrelatedPackages);
+
+private:
+	/** The mod's package set, collected if it isn't known yet. nullptr if it couldn't be resolved */
+	const TSet<FName>* ResolveMod(const FString& ModName);
+	void Invalidate();
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext ObjectSaveContext);
+
+	TMap<FString, FModCookSet> ModPackages;
+	TMap<FString, TSet<FName>> ModPackageSets;
+
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle PackageSavedHandle;
+};
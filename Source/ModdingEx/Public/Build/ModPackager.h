@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FModBuildContext;
+
+/**
+ * Packs the cooked output of a previous build without going through UAT, used when only packaging settings changed.
+ * Runs UnrealPak for the pak file and the IoStore commandlet for the .utoc/.ucas container.
+ */
+namespace ModPackager
+{
+	/** Folder with the cooked assets of the mod, only exists for builds with persistent staging */
+	FString GetCookedModDir(const FModBuildContext& Context);
+
+	bool HasCookedOutput(const FModBuildContext& Context);
+
+	/**
+	 * Pack the cooked assets into the staging dir and fill the output files of the context. Blocks, so call it off the game thread
+	 *
+	 * @param Context Build to pack, ErrorMessage is set on failure
+	 * @param OnOutput Gets every line printed by UnrealPak and the IoStore commandlet
+	 */
+	bool Package(FModBuildContext& Context, const TFunction<void(const FString& Line)>& OnOutput);
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ModSizeReport.generated.h"
+
+/** A package in the built containers, all of its files (uasset, uexp, ubulk, ...) summed up */
+USTRUCT()
+struct FModSizeReportPackage
+{
+	GENERATED_BODY()
+
+	/** Long package name, or the path in the container for files that aren't packages */
+	UPROPERTY()
+	FString PackageName;
+
+	UPROPERTY()
+	FString AssetClass;
+
+	UPROPERTY()
+	int64 CompressedSize = 0;
+
+	UPROPERTY()
+	int64 UncompressedSize = 0;
+};
+
+/** Packages summed up by directory or asset class */
+USTRUCT()
+struct FModSizeReportGroup
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString Name;
+
+	UPROPERTY()
+	int32 Packages = 0;
+
+	UPROPERTY()
+	int64 CompressedSize = 0;
+
+	UPROPERTY()
+	int64 UncompressedSize = 0;
+};
+
+/** What a built mod consists of, stored per mod to compare against the next build */
+USTRUCT()
+struct FModSizeReport
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString ModName;
+
+	UPROPERTY()
+	FString Time;
+
+	UPROPERTY()
+	int64 CompressedSize = 0;
+
+	UPROPERTY()
+	int64 UncompressedSize = 0;
+
+	/** Sorted by compressed size, largest first */
+	UPROPERTY()
+	TArray<FModSizeReportPackage> Packages;
+
+	UPROPERTY()
+	TArray<FModSizeReportGroup> Directories;
+
+	UPROPERTY()
+	TArray<FModSizeReportGroup> Classes;
+};
+
+namespace ModSizeReport
+{
+	/** Saved/ModdingEx/SizeReports/<ModName>.json */
+	FString GetReportPath(const FString& ModName);
+
+	bool Load(const FString& ModName, FModSizeReport& OutReport);
+	bool Save(const FString& ModName, const FModSizeReport& Report);
+
+	/**
+	 * Read the index of the built pak and the TOC of the IoStore container next to it, if there is one.
+	 * Asset classes are looked up in the Asset Registry, so call it on the game thread.
+	 *
+	 * @param ModName Mod the containers belong to
+	 * @param PakPath Path of <ModName>.pak, a <ModName>.utoc next to it is read as well
+	 * @param OutReport Sizes per package, directory and class
+	 * @return false if the pak couldn't be read
+	 */
+	bool Generate(const FString& ModName, const FString& PakPath, FModSizeReport& OutReport);
+
+	/** Log the largest packages, directories and classes */
+	void LogTopContributors(const FModSizeReport& Report, int32 Count);
+
+	/**
+	 * Compare two builds of a mod
+	 *
+	 * @param Previous Report of the last build
+	 * @param Current Report of this build
+	 * @param ThresholdPercent Growth of the compressed size that is worth reporting
+	 * @param Count How many of the packages that grew the most to name
+	 * @return Description of the growth, empty if the mod didn't grow more than the threshold
+	 */
+	FString DescribeGrowth(const FModSizeReport& Previous, const FModSizeReport& Current, float ThresholdPercent, int32 Count);
+}
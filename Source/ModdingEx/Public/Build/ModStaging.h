@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Where builds stage and cook, picked from StagingLocation and checked for enough free space before UAT starts */
+namespace ModStaging
+{
+	/**
+	 * Space a build of the mods needs for its cooked, staged and packed files, a rough multiple of the content cooked into them
+	 *
+	 * @param ModNames Mods whose content dirs are cooked
+	 * @param ExternalPackageFiles Referenced packages outside the mod dirs that are cooked into the mods as well
+	 */
+	int64 EstimateRequiredBytes(const TArray<FString>& ModNames, const TArray<FString>& ExternalPackageFiles);
+
+	/** RAM disk the Auto location may use, empty if there is none */
+	FString FindRamDisk();
+
+	/**
+	 * Pick the dir the ModdingExStaging and ModdingExCooked dirs go into.
+	 * Auto only picks the RAM disk if it and the physical memory still have room for the build and a cooker next to it.
+	 * For persistent staging Auto sticks to the dir it picked first while that still holds the cook and has room,
+	 * moving would start the iterative cook over.
+	 *
+	 * @param RequiredBytes Space the build is expected to take, from EstimateRequiredBytes
+	 * @param bPersistent Whether the build keeps its staging and cook dirs
+	 * @param bOutIsRamDisk Whether the picked dir is the RAM disk
+	 */
+	FString ResolveRoot(int64 RequiredBytes, bool bPersistent, bool& bOutIsRamDisk);
+
+	/**
+	 * Check that the volume of the dir has room for the build, the dir is created if it doesn't exist
+	 *
+	 * @param OutError Why the build can't start, set if this returns false
+	 */
+	bool HasFreeSpace(const FString& Dir, int64 RequiredBytes, FString& OutError);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "IDirectoryWatcher.h"
+
+struct FObjectPostSaveContext;
+
+/**
+ * Rebuilds and redeploys watched mods in the background whenever their assets change.
+ * Changes come from saved packages that belong to the mod and from files changed on disk in Content/Mods/<Mod>.
+ * They are debounced, and a change while the mod is being built cancels that build so the next one starts from the new state.
+ */
+class FModWatcher
+{
+public:
+	~FModWatcher();
+
+	bool IsWatching(const FString& ModName) const;
+	void SetWatching(const FString& ModName, bool bWatch);
+
+	/** Stop watching all mods, called before the module shuts down */
+	void Shutdown();
+
+private:
+	struct FWatchedMod
+	{
+		FDelegateHandle DirectoryHandle;
+		double LastChangeTime = 0.0;
+		bool bChangePending = false;
+	};
+
+	void OnChange(const FString& ModName);
+	void OnDirectoryChanged(const TArray<FFileChangeData>& Changes, FString ModName);
+	void OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext ObjectSaveContext);
+	bool Tick(float DeltaTime);
+
+	FString GetWatchedDir(const FString& ModName) const;
+
+	TMap<FString, FWatchedMod> WatchedMods;
+
+	FDelegateHandle PackageSavedHandle;
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	/** Set while a watch build saves packages, those saves must not trigger another build */
+	bool bStartingBuild = false;
+};
@@ -1,13 +1,31 @@
 ﻿#pragma once
 #include "CoreMinimal.h"
+#include "Async/Future.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
-#include "FileUtilities/ZipArchiveWriter.h"
 #include "ModBuilder.generated.h"
 
+struct FModBuildContext;
+class FModBuildProcess;
+
+UENUM(BlueprintType)
+enum class EModBuildResult : uint8
+{
+	Failed,
+	/** Built and deployed to the output folder */
+	Built,
+	/** Built, but the output matched the deployed files so nothing was copied */
+	ContentUnchanged,
+	/** Stopped before deploying, the previously deployed files are untouched */
+	Cancelled
+};
+
 UCLASS(Blueprintable)
 class UModBuilder : public UBlueprintFunctionLibrary
 {
 	GENERATED_BODY()
+
+	// Zips the finished builds itself through ZipModInternal and GetZipOutputDir to report on each
+	friend class UModdingExBuildCommandlet;
 	
 private:
 	static void EditDirectoriesToAlwaysCook(const FString& DirectoryToCook, const bool bShouldRemove = false);
@@ -22,6 +40,11 @@ private:
 
 	static bool ZipModInternal(const FString& ModName);
 
+	static FString GetZipOutputDir();
+
+	/** Whether the zip should be recreated after a build, an unchanged mod keeps its existing zip unless bZipWhenContentIsSame is set */
+	static bool ShouldRezip(const FString& ModName, EModBuildResult BuildResult);
+
 	static void CreateModManifest(FString& OutModManifest, const FString& ModName, const FString& WebsiteUrl,
 	                              const FString& Dependencies, const FString& ModDesc, const FString& ModVersion);
 
@@ -32,7 +55,50 @@ private:
 
 	static FString* FindFStringPropertyValue(UObject* Object, const FName& PropertyName);
 
-	TPromise<bool> BuildModAsync(const FString& ModName, bool bForceRebuild);
+	/** Game thread part before UAT runs: saves packages, resolves the output and staging dirs and assembles the UAT arguments */
+	static bool PrepareBuild(FModBuildContext& Context);
+
+	/** Runs UAT and streams its output into the log, blocks the calling thread */
+	static bool RunUat(FModBuildContext& Context, FModBuildProcess& Process);
+
+	/** Hashes the mod assets and compares them and the build settings against the last build, can run on any thread */
+	static bool IsBuildUpToDate(FModBuildContext& Context);
+
+	/** Worker thread part: skips UAT if the mod is up to date, deploys from the build cache if possible, packs the last cook if only packaging changed, otherwise runs UAT and collects the staged files */
+	static bool ExecuteBuild(FModBuildContext& Context, FModBuildProcess& Process);
+
+	/** Takes the output files from the build cache if the mod was built with the same assets and settings before */
+	static bool RestoreFromCache(FModBuildContext& Context);
+
+	/** Adds freshly built output files to the build cache and evicts old entries above the size cap */
+	static void StoreInCache(const FModBuildContext& Context);
+
+	/** Hashes the output files against the deployed ones and sets bContentUnchanged if enabled */
+	static void CompareWithDeployed(FModBuildContext& Context);
+
+	/** Swaps the staged files into the output dir unless they match the deployed ones, blocks while other processes hold the files open */
+	static bool DeployBuildOutput(FModBuildContext& Context);
+
+	/** Records the inputs and deployed files so the next build can be skipped if nothing changes */
+	static void SaveBuildManifest(const FModBuildContext& Context);
+
+	/** Finds the staged files after UAT ran and hashes them against the deployed ones, can run on any thread */
+	static bool CollectBuildOutput(FModBuildContext& Context);
+
+	/** Game thread part after the worker finished: cleans up, records the manifest and reports the result */
+	static EModBuildResult FinishBuild(FModBuildContext& Context, bool bOutputReady);
+
+	/** Runs a prepared build while showing a modal progress dialog */
+	static EModBuildResult RunBuildBlocking(FModBuildContext& Context);
+
+	/** Runs a prepared build in the background with a progress notification, commandlets only log the progress */
+	static TFuture<EModBuildResult> RunBuildAsync(const TSharedRef<FModBuildContext>& Context);
+
+	/** Resolves the chunk of every mod for a single cook, fails if two mods share a chunk */
+	static bool CreateBatchContext(const TArray<FString>& ModNames, TSharedPtr<FModBuildContext>& OutContext);
+
+	/** Builds the mod while showing a modal progress dialog */
+	static EModBuildResult BuildModBlocking(const FString& ModName, bool bCheckHash = true, bool bForceRebuild = false);
 
 public:
 	static bool ExecGenericCommand(const TCHAR* Command, const TCHAR* Params, int32* OutReturnCode, FString* OutStdOut, FString* OutStdErr);
@@ -40,12 +106,43 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Mod Building")
 	static bool BuildMod(const FString& ModName, bool bIsSameContentError = true);
 
+	/**
+	 * Build the mod with UAT running in the background, the editor stays responsive while cooking.
+	 * The future is fulfilled on the game thread, so continuations attached with Next can touch editor state.
+	 *
+	 * @param bCheckHash Skip deploying if the output matches the deployed files (only if bShouldCheckHash is set)
+	 * @param bForceRebuild Run UAT even if no mod asset or build setting changed since the last build
+	 */
+	static TFuture<EModBuildResult> BuildModAsync(const FString& ModName, bool bCheckHash = true, bool bForceRebuild = false);
+
+	/** Like BuildModAsync, but with a context set up by the caller, who can follow its progress and read the results from it */
+	static TFuture<EModBuildResult> BuildModAsync(const TSharedRef<FModBuildContext>& Context);
+
+	/**
+	 * Cook several mods in a single UAT run and split the output into one pak per mod.
+	 * Each mod gets a stable chunk ID through a Primary Asset Label in its folder, so Generate Chunks has to be enabled in the packaging settings.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Mod Building")
+	static bool BuildMods(const TArray<FString>& ModNames);
+
+	/** Like BuildMods, but UAT runs in the background */
+	static TFuture<EModBuildResult> BuildModsAsync(const TArray<FString>& ModNames);
+
+	/** Whether a build of the mod is in flight, on its own or as part of a batch */
+	static bool IsModBuilding(const FString& ModName);
+
+	/** Stop the build of the mod, the running tool is killed and the deployed files are left as they are */
+	static void CancelBuild(const FString& ModName);
+
 	// UFUNCTION(BlueprintCallable, Category = "Mod Building")
 	// static bool PrepareModForRelease(const FString& ModName, const FString& WebsiteUrl, const FString& Dependencies);
 
 	UFUNCTION(BlueprintCallable, Category = "Mod Building")
 	static bool ZipMod(const FString& ModName);
 
+	/** Like ZipMod, but builds in the background first if bAlwaysBuildBeforeZipping is set */
+	static TFuture<bool> ZipModAsync(const FString& ModName);
+
 	// UFUNCTION(BlueprintCallable, Category = "Mod Building")
 	// static bool UninstallMod(const FString& ModName);
 
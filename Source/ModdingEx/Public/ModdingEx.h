@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 #include "ModdingExSection.h"
+#include "Build/ModWatcher.h"
 #include "Thunderstore/Thunderstore.h"
 
 class FToolBarBuilder;
@@ -27,9 +28,14 @@ public:
 	FReply TryStartGame() const;
 	void OnOpenGameFolder() const;
 	void OnOpenRepository() const;
+	void OnOpenBuildHistory() const;
+	void OnOpenBuildQueue() const;
 
 	FOnModManagerChanged OnModManagerChanged;
 
+	static const FName BuildHistoryTabName;
+	static const FName BuildQueueTabName;
+
 private:
 	void RegisterMenus();
 
@@ -38,6 +44,8 @@ private:
 	TArray<FModdingExSection> Sections;
 
 	FThunderstore Thunderstore;
+
+	FModWatcher ModWatcher;
 	
 	// List of mods that can be build before starting the game + "None"
 	TArray<TSharedPtr<FString>> StartBuildMods;
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ModdingExBuildCommandlet.generated.h"
+
+struct FModBuildContext;
+struct FModBuildReportMod;
+enum class EModBuildResult : uint8;
+
+/**
+ * Builds, zips and stages mods without the editor UI, for CI.
+ *
+ * UnrealEditor-Cmd <Project>.uproject -run=ModdingExBuild [-Mods=A+B] [-Zip] [-StageDir=<Dir>] [-Parallel=<N>]
+ *     [-Report=<File>] [-OutputDir=<Dir>] [-ZipDir=<Dir>] [-Platform=<Platform>] [-Force]
+ *
+ * Without -Mods every mod with a ModActor is built. Without -Parallel as many mods are built at once as the cores and memory allow.
+ * -OutputDir and -ZipDir override CustomPakDir and ModZipDir for this run.
+ * Returns 0 if every mod was built (and zipped and staged if asked for), 1 otherwise.
+ * Windows only like the rest of the plugin, the bundled libzip is a Windows build and lock holders are found with the Restart Manager.
+ */
+UCLASS()
+class UModdingExBuildCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UModdingExBuildCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/** Zip and stage a finished build if asked for and describe it for the report */
+	static FModBuildReportMod FinishModBuild(const FModBuildContext& Context, EModBuildResult Result, bool bZip, const FString& StageDir);
+};
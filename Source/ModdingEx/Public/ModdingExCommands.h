@@ -21,4 +21,6 @@ public:
 	TSharedPtr<FUICommandInfo> OpenPluginSettings;
 	TSharedPtr<FUICommandInfo> OpenGameFolder;
 	TSharedPtr<FUICommandInfo> OpenRepository;
+	TSharedPtr<FUICommandInfo> OpenBuildHistory;
+	TSharedPtr<FUICommandInfo> OpenBuildQueue;
 };
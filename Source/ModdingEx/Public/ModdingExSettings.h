@@ -23,6 +23,22 @@ enum class EModManager : uint8
 	Thunderstore UMETA(DisplayName = "Thunderstore")
 };
 
+UENUM(BlueprintType)
+enum class EModCodeBuild : uint8
+{
+	Auto UMETA(DisplayName = "Auto", ToolTip = "Only build the game target if it was never built or its source changed"),
+	Always UMETA(DisplayName = "Always"),
+	Never UMETA(DisplayName = "Never")
+};
+
+UENUM(BlueprintType)
+enum class EModStagingLocation : uint8
+{
+	Intermediate UMETA(DisplayName = "Intermediate", ToolTip = "Stage and cook in the Intermediate dir of the project"),
+	Custom UMETA(DisplayName = "Custom", ToolTip = "Stage and cook in CustomStagingDir"),
+	Auto UMETA(DisplayName = "Auto", ToolTip = "Stage and cook on a RAM disk while enough memory is free, in Intermediate otherwise")
+};
+
 USTRUCT()
 struct FModManagers
 {
@@ -101,10 +117,50 @@ public:
 	UPROPERTY(Config, EditAnywhere, Category = "Building")
 	TArray<FString> ProcessesToKill = { "FModel.exe" };
 
-	/** If true will kill the processes specified in ProcessesToKill before building the mod */
+	/** If true will kill the processes specified in ProcessesToKill if they still hold the mod files open after DeployLockTimeout */
 	UPROPERTY(Config, EditAnywhere, Category = "Building")
 	bool bShouldKillProcesses = true;
 
+	/** Seconds to wait for other processes to close the deployed mod files before killing them or failing the build */
+	UPROPERTY(Config, EditAnywhere, Category = "Building", meta = (ClampMin = "0"))
+	float DeployLockTimeout = 10.0f;
+
+	/** Keep built paks in Intermediate/ModdingExCache and deploy them again when a mod returns to assets and settings it was already built with */
+	UPROPERTY(Config, EditAnywhere, Category = "Building")
+	bool bUseBuildCache = false;
+
+	/** Size in MB the build cache may grow to before the least recently used builds are deleted */
+	UPROPERTY(Config, EditAnywhere, Category = "Building", meta = (ClampMin = "0", EditCondition = "bUseBuildCache"))
+	int32 BuildCacheSizeMB = 2048;
+
+	/** Seconds without further changes before a watched mod is rebuilt, so saving several assets in a row builds once */
+	UPROPERTY(Config, EditAnywhere, Category = "Building", meta = (ClampMin = "0"))
+	float WatchDebounceSeconds = 1.0f;
+
+	/** Read the built pak and IoStore container after a build and log what takes up the space, stored in Saved/ModdingEx/SizeReports */
+	UPROPERTY(Config, EditAnywhere, Category = "Building")
+	bool bGenerateSizeReport = true;
+
+	/** Growth of the compressed mod size in percent since the last build that gets pointed out in the build notification */
+	UPROPERTY(Config, EditAnywhere, Category = "Building", meta = (ClampMin = "0", EditCondition = "bGenerateSizeReport"))
+	float SizeGrowthWarningPercent = 10.0f;
+
+	/** How many of the largest packages, directories and classes the size report lists */
+	UPROPERTY(Config, EditAnywhere, Category = "Building", meta = (ClampMin = "1", EditCondition = "bGenerateSizeReport"))
+	int32 SizeReportTopCount = 10;
+
+	/** Mod builds the build queue runs at once, 0 picks as many as the cores and the physical memory allow */
+	UPROPERTY(Config, EditAnywhere, Category = "Building", meta = (ClampMin = "0"))
+	int32 MaxParallelBuilds = 0;
+
+	/** Cores a single cook keeps busy, used to pick how many builds run at once */
+	UPROPERTY(Config, EditAnywhere, Category = "Building", meta = (ClampMin = "1"))
+	int32 CoresPerBuild = 4;
+
+	/** Memory in MB a single cooker takes, a queued build only starts while this much is free */
+	UPROPERTY(Config, EditAnywhere, Category = "Building", meta = (ClampMin = "0"))
+	int32 CookerMemoryMB = 4096;
+
 	/** When chosen a mod to build before starting the game via the button, this will cancel the start if the mod building wasn't successul */
 	UPROPERTY(Config, EditAnywhere, Category = "Building")
 	bool bShouldStartGameAfterFailedBuild = false;
@@ -113,6 +169,47 @@ public:
 	UPROPERTY(Config, EditAnywhere, Category = "Building")
 	bool bSaveAllBeforeBuilding = true;
 
+	/** Only save the dirty packages the mod consists of, other open levels and assets are left unsaved and listed once the build finishes */
+	UPROPERTY(Config, EditAnywhere, Category = "Building", meta = (EditCondition = "bSaveAllBeforeBuilding"))
+	bool bOnlySaveModPackages = false;
+
+	/** When UAT should compile the game target before cooking, content-only mods don't need it and it costs a UBT run per build */
+	UPROPERTY(Config, EditAnywhere, Category = "Building")
+	EModCodeBuild CodeBuild = EModCodeBuild::Auto;
+
+	/** Skip running UAT if no asset of the mod and no packaging setting changed since the last successful build */
+	UPROPERTY(Config, EditAnywhere, Category = "Building")
+	bool bSkipBuildIfUnchanged = false;
+
+	/**
+	 * Keep a staging and cook dir per mod and cook iteratively, so only changed assets are cooked again.
+	 * If a build picks up stale content, delete ModdingExStaging and ModdingExCooked at the staging location or turn this off again.
+	 * Also lets a build whose assets didn't change only run UnrealPak on the kept cook, e.g. after a pak setting changed, a deployed pak
+	 * was removed or with bSkipBuildIfUnchanged off. That needs the previous build's manifest and a mod without assets outside its folder
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Building")
+	bool bUsePersistentStaging = false;
+
+	/** Where UAT stages and cooks, a RAM disk saves the disk I/O of every build and the wear on the SSD */
+	UPROPERTY(Config, EditAnywhere, Category = "Building")
+	EModStagingLocation StagingLocation = EModStagingLocation::Intermediate;
+
+	/** Dir to stage and cook in if StagingLocation is Custom */
+	UPROPERTY(Config, EditAnywhere, Category = "Building", meta = (EditCondition = "StagingLocation == EModStagingLocation::Custom", EditConditionHides))
+	FDirectoryPath CustomStagingDir;
+
+	/** RAM disk the Auto staging location uses, /dev/shm is used on Linux if this is empty */
+	UPROPERTY(Config, EditAnywhere, Category = "Building", meta = (EditCondition = "StagingLocation == EModStagingLocation::Auto", EditConditionHides))
+	FDirectoryPath RamDiskDir;
+
+	/** Free space in MB a build needs at the staging location on top of three times the size of the mod content, checked before UAT starts */
+	UPROPERTY(Config, EditAnywhere, Category = "Building", meta = (ClampMin = "0"))
+	int32 MinFreeStagingSpaceMB = 512;
+
+	/** Chunk each mod is cooked into when building several mods at once, assigned automatically and kept stable between builds */
+	UPROPERTY(Config, EditAnywhere, Category = "Building")
+	TMap<FString, int32> ModChunkIds;
+
 	/** If you are uploading your mod on Curseforge */
 	UPROPERTY(Config, EditAnywhere, Category = "Mod Manager")
 	bool bUsingCurseforge = true;
@@ -141,6 +238,25 @@ public:
 	UPROPERTY(Config, EditAnywhere, Category = "Zipping")
 	FDirectoryPath ModZipDir = { "Saved/Zips" };
 
+	/** Store files that barely shrink when deflated, like paks and IoStore containers the engine already compressed, instead of deflating them again */
+	UPROPERTY(Config, EditAnywhere, Category = "Zipping")
+	bool bStoreCompressedFiles = true;
+
+	/**
+	 * Zip the same files to the same bytes: fixed timestamps, entries sorted by name and a block layout that doesn't depend on the thread count.
+	 * A <Mod>.zip.sha1 is written next to the zip, and a mod whose files didn't change since its last zip isn't zipped again
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Zipping")
+	bool bDeterministicZips = false;
+
+	/** Copy files that didn't change since the last zip out of the existing zip as they are, only changed files are compressed again */
+	UPROPERTY(Config, EditAnywhere, Category = "Zipping")
+	bool bUpdateZipsIncrementally = false;
+
+	/** Threads deflating a large file at once while zipping, 0 uses every core. Files are split into blocks that are compressed side by side */
+	UPROPERTY(Config, EditAnywhere, Category = "Zipping", meta = (ClampMin = "0"))
+	int32 ZipCompressionThreads = 0;
+
 	/** If true will open the folder where the zipped mod was saved to after zipping */
 	UPROPERTY(Config, EditAnywhere, Category = "Zipping")
 	bool bOpenZipFolderAfterZipping = true;
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ModdingExZipBenchmarkCommandlet.generated.h"
+
+/**
+ * Zips the given files with the engine's FZipArchiveWriter, with FModZipWriter on one thread and with FModZipWriter on
+ * several threads with and without storing already compressed files, and logs the time and size of each, to pick
+ * ZipCompressionThreads for a machine.
+ *
+ * UnrealEditor-Cmd <Project>.uproject -run=ModdingExZipBenchmark -Files=A.ucas+B.pak [-Threads=<N>] [-Runs=<N>]
+ */
+UCLASS()
+class UModdingExZipBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UModdingExZipBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
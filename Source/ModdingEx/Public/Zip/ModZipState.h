@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Tracks which inputs a deterministic mod zip was made from, so an unchanged mod isn't zipped again, and writes the
+ * <Mod>.zip.sha1 file next to the zip that uploads and caches can compare instead of the zip itself
+ */
+namespace ModZipState
+{
+	/** Path of the hash file next to the zip, in sha1sum format */
+	FString GetHashFilePath(const FString& ZipPath);
+
+	/**
+	 * Key over the names and content of the files going into the zip and the settings that change its bytes
+	 *
+	 * @param FilePaths Files in the order they are added to the zip
+	 * @return Returns an empty key if a file couldn't be read
+	 */
+	FString ComputeInputKey(const TArray<FString>& FilePaths, bool bStoreCompressedFiles);
+
+	/** Whether the zip exists and was made from the inputs with this key, and its hash file still matches it */
+	bool IsUpToDate(const FString& ZipPath, const FString& InputKey);
+
+	/**
+	 * Hash the finished zip, write its hash file and remember the inputs it was made from
+	 *
+	 * @param OutZipHash SHA1 of the zip, set if this returns true
+	 */
+	bool Record(const FString& ZipPath, const FString& InputKey, FString& OutZipHash);
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+
+enum class EModZipMethod : uint8
+{
+	Store,
+	Deflate
+};
+
+/** How a file should go into the zip, from deflating a few samples of it */
+struct FModZipMethodChoice
+{
+	EModZipMethod Method = EModZipMethod::Deflate;
+
+	/** Deflated size of the samples relative to their size, 1 if the file wasn't sampled */
+	double SampleRatio = 1.0;
+
+	/** Seconds deflating the whole file on one thread would take, extrapolated from the samples */
+	double EstimatedDeflateSeconds = 0.0;
+};
+
+/**
+ * Writes a zip to disk entry by entry. Files are streamed through fixed size buffers, read, compressed and written a block at a time,
+ * so zipping a multi GB container takes as much memory as a small one. Zip64 records are added where sizes or offsets need them.
+ * Large entries are deflated on several threads in independent blocks that still form one standard deflate stream.
+ */
+class FModZipWriter
+{
+public:
+	/** Bytes read from the source and handed to the compressor at once */
+	static constexpr int64 BlockSize = 1024 * 1024;
+
+	FModZipWriter() = default;
+	~FModZipWriter();
+
+	FModZipWriter(const FModZipWriter&) = delete;
+	FModZipWriter& operator=(const FModZipWriter&) = delete;
+
+	/**
+	 * Sample the file to decide if deflating it is worth the time. Paks and IoStore containers are usually compressed already
+	 * and barely shrink, they are stored. Text files are always deflated
+	 */
+	static FModZipMethodChoice ChooseMethod(const FString& FilePath);
+
+	/** CRC32 of a file as the zip stores it, streamed through a block sized buffer */
+	static bool ComputeCrc(const FString& FilePath, uint32& OutCrc);
+
+	/** Threads deflating a large entry at once, 0 uses every core and 1 deflates on the calling thread */
+	void SetNumThreads(int32 InNumThreads) { NumThreads = InNumThreads; }
+
+	/**
+	 * Write the same bytes for the same content: timestamps are replaced with 1980-01-01 and large entries are always deflated in
+	 * blocks, so the output doesn't depend on the thread count. The caller keeps the entry order stable
+	 */
+	void SetDeterministic(bool bInDeterministic) { bDeterministic = bInDeterministic; }
+
+	/** Create the zip file, an existing file is overwritten */
+	bool Open(const FString& ZipPath);
+
+	/** Stream a file from disk into the zip */
+	bool AddFile(const FString& NameInZip, const FString& SourcePath, EModZipMethod Method, const FDateTime& Timestamp);
+
+	/** Add a small in-memory file such as a manifest */
+	bool AddData(const FString& NameInZip, TConstArrayView<uint8> Data, EModZipMethod Method, const FDateTime& Timestamp);
+
+	/**
+	 * Copy an entry that is already compressed, such as an unchanged entry of a previous zip, without recompressing it
+	 *
+	 * @param Crc CRC32 of the uncompressed data
+	 * @param Read Fills the buffer with the next compressed bytes, called with at most BlockSize bytes until CompressedSize bytes were read
+	 */
+	bool AddRawEntry(const FString& NameInZip, EModZipMethod Method, uint32 Crc, int64 UncompressedSize, int64 CompressedSize, const FDateTime& Timestamp,
+		TFunctionRef<bool(uint8* Buffer, int64 Num)> Read);
+
+	/** Write the central directory and close the file, the zip is only valid after this succeeded */
+	bool Close();
+
+	/** Size in the zip of the last added entry */
+	int64 GetLastEntryCompressedSize() const { return Entries.IsEmpty() ? 0 : Entries.Last().CompressedSize; }
+
+	/** Why the last call failed */
+	const FString& GetError() const { return Error; }
+
+private:
+	struct FEntry
+	{
+		TArray<uint8> Name;
+		uint16 Flags = 0;
+		uint16 Method = 0;
+		uint32 DosTime = 0;
+		uint32 Crc = 0;
+		uint64 CompressedSize = 0;
+		uint64 UncompressedSize = 0;
+		uint64 Offset = 0;
+		bool bZip64 = false;
+	};
+
+	/**
+	 * Write the local header, stream the data through the compressor and patch the sizes and CRC into the header afterwards
+	 *
+	 * @param Read Fills the buffer with the next bytes of the entry, called with at most BlockSize bytes until Size bytes were read
+	 */
+	bool AddEntry(const FString& NameInZip, int64 Size, EModZipMethod Method, const FDateTime& Timestamp, TFunctionRef<bool(uint8* Buffer, int64 Num)> Read);
+
+	/** Fill in the entry and write its local header with the CRC and sizes left out */
+	bool BeginEntry(const FString& NameInZip, int64 Size, EModZipMethod Method, const FDateTime& Timestamp, FEntry& Entry);
+
+	/** Patch the CRC and sizes of the data written since DataStart into the local header and add the entry to the central directory */
+	bool FinishEntry(FEntry&& Entry, int64 DataStart, const FString& NameInZip);
+
+	/** Stream the entry through a single deflate stream or store it, sets the CRC */
+	bool WriteData(FEntry& Entry, int64 Size, TFunctionRef<bool(uint8* Buffer, int64 Num)> Read);
+
+	/** Deflate batches of one block per thread on the task graph and write them in order, sets the CRC */
+	bool WriteDeflatedParallel(FEntry& Entry, int64 Size, int32 ThreadCount, TFunctionRef<bool(uint8* Buffer, int64 Num)> Read);
+
+	int32 GetNumThreads() const;
+
+	bool Write(const TArray<uint8>& Bytes);
+	bool Write(const uint8* Bytes, int64 Num);
+
+	TUniquePtr<IFileHandle> Handle;
+	TArray<FEntry> Entries;
+	FString ZipPath;
+	FString Error;
+	int32 NumThreads = 0;
+	bool bDeterministic = false;
+};
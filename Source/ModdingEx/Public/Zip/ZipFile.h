@@ -59,6 +59,10 @@ struct FZipEntry
 	uint64 Index;
 	uint64 DecompressedSize;
 	uint64 CompressedSize;
+	uint32 Crc;
+
+	/** Zip compression method, 0 for stored and 8 for deflated entries */
+	uint16 CompressionMethod;
 
 public:
 	FZipEntry() = default;
@@ -69,6 +73,8 @@ public:
 	FZipEntry(FZipEntry&& Other) noexcept : Name(std::exchange(Other.Name, {})), Index(std::exchange(Other.Index, {})),
 	                                        DecompressedSize(std::exchange(Other.DecompressedSize, {})),
 	                                        CompressedSize(std::exchange(Other.CompressedSize, {})),
+	                                        Crc(std::exchange(Other.Crc, {})),
+	                                        CompressionMethod(std::exchange(Other.CompressionMethod, {})),
 	                                        File(std::exchange(Other.File, nullptr))
 	{
 	}
@@ -79,6 +85,8 @@ public:
 		Swap(Index, Other.Index);
 		Swap(DecompressedSize, Other.DecompressedSize);
 		Swap(CompressedSize, Other.CompressedSize);
+		Swap(Crc, Other.Crc);
+		Swap(CompressionMethod, Other.CompressionMethod);
 		Swap(File, Other.File);
 		return *this;
 	}
@@ -111,6 +119,16 @@ public:
 	 */
 	static bool TryCreateZipFile(const TArray<uint8>& Data, FZipFile& ZipFile, FZipError& Error);
 
+	/**
+	 * Try to open a zip file on disk, entries are read from the file as needed
+	 *
+	 * @param Path Path of the zip
+	 * @param ZipFile Result file, gets set if opening succeeded
+	 * @param Error Error, gets set if opening failed
+	 * @return Returns if opening was successful
+	 */
+	static bool TryOpenZipFile(const FString& Path, FZipFile& ZipFile, FZipError& Error);
+
 public:
 	/**
 	 * 
@@ -124,9 +142,10 @@ public:
 	 * 
 	 * @param Index Entry index
 	 * @param Error Error, gets set if getting the entry failed
+	 * @param bCompressed Read the compressed bytes as they are stored instead of the decompressed data
 	 * @return Entry, if one exists
 	 */
-	TOptional<FZipEntry> GetEntryIndex(uint64 Index, FZipError& Error) const;
+	TOptional<FZipEntry> GetEntryIndex(uint64 Index, FZipError& Error, bool bCompressed = false) const;
 	
 	/**
 	 * Get all entries from this zip 
@@ -138,6 +157,13 @@ public:
 	
 	TArray<uint8> ReadEntry(const FZipEntry& Entry) const;
 
+	/**
+	 * Read the next bytes of an entry, for streaming entries too large to read at once
+	 *
+	 * @return Returns if exactly Num bytes were read
+	 */
+	bool ReadEntry(const FZipEntry& Entry, uint8* Buffer, int64 Num) const;
+
 public:
 	FZipFile() = default;
 